@@ -1,14 +1,25 @@
 #include <vector>
+#include <array>
+#include <string>
+#include <map>
+#include <memory>
 
+#include <QtCore/QStringList>
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QMainWindow>
 #include <QtWidgets/QScrollArea>
 #include <QtWidgets/QPushButton>
-#include <QtWidgets/QGridLayout>
 #include <QtWidgets/QAction>
+#include <QtWidgets/QActionGroup>
+#include <cpr/session.h>
 
+#include <DropModel.hh>
 #include <InvestigationEntry.hh>
 #include <DropSelectHandler.hh>
+#include <InputLatency.hh>
+#include <DropClassifier.hh>
+#include <RouteLayout.hh>
+#include <SpotStatsIndex.hh>
 
 #ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_APPWINDOW_HH_
 #define INCLUDE_GENSHINARTIFACTSPAWNSTAT_APPWINDOW_HH_
@@ -18,26 +29,51 @@ namespace GenshinArtifactSpawnStat {
 class AppWindow : public QMainWindow {
 
 	inline static constexpr auto HOST = "localhost:3000";
+	inline static constexpr auto STATS_BINARY_TYPE = "application/vnd.genshinartifactspawnstat.stats";
 	inline static constexpr int BUTTON_WIDTH = 50;
 	inline static constexpr int SPACING = 5;
 
-	inline static auto ROUTE_FILE = "route.dat";
+	inline static auto ROUTE_FILE = "route.dat"; // single route of older versions
+	inline static auto ROUTES_FILE = "routes.dat";
+	inline static auto DEFAULT_ROUTE = "default";
 
 	QMenu* m_file_menu = nullptr;
 	QMenu* m_edit_menu = nullptr;
+	QMenu* m_view_menu = nullptr;
 	QAction* m_load_action = nullptr;
 	QAction* m_save_action = nullptr;
 	QAction* m_send_action = nullptr;
 	QAction* m_zoom_action = nullptr;
+	QAction* m_classify_action = nullptr;
 	QAction* m_edit_route_action = nullptr;
 	QAction* m_save_route_action = nullptr;
+	QAction* m_new_route_action = nullptr;
+	QAction* m_delete_route_action = nullptr;
+	QAction* m_filter_action = nullptr;
+	QAction* m_sort_action = nullptr;
+	QAction* m_reset_view_action = nullptr;
+	QAction* m_input_latency_action = nullptr;
+	QMenu* m_route_menu = nullptr;
+	QActionGroup* m_route_group = nullptr;
 	QScrollArea* m_central = nullptr;
-	QGridLayout* m_layout = nullptr;
+	RouteLayout* m_layout = nullptr;
+
+	struct Route {
+		std::vector<std::size_t> row_order;
+		std::unique_ptr<DropSelectHandler> navigation; // kept while the route is unchanged
+	};
 
 	std::vector<QPushButton*> m_entry_buttons;
 	std::vector<InvestigationEntry*> m_entries;
-	std::vector<std::size_t> m_row_order;
-	DropSelectHandler* m_selecthandler = nullptr;
+	DropModel m_drops;
+	InputLatency m_input_latency;
+	std::vector<std::size_t> m_row_order; // shown, only a confirmed route order is stored in m_routes
+	std::map<std::string, Route> m_routes;
+	std::string m_current_route;
+	SpotStatsIndex m_stats_index;
+	SpotStatsIndex::View m_view;
+	std::unique_ptr<DropSelectHandler> m_view_navigation; // while a filtered/sorted view is shown
+	cpr::Session m_session; // kept alive between requests to reuse the connection
 
 	void create_menu();
 	void create_entries();
@@ -47,20 +83,35 @@ class AppWindow : public QMainWindow {
 	void install_keyboard_navigation();
 	void remove_keyboard_navigation();
 	void route_mode(bool activate);
-	void save_route() const;
-	void load_route();
-	std::string drops_as_json() const;
+	void remove_view_navigation();
+	void show_rows();
+	static QStringList metric_names();
+	void select_route(const std::string& name);
+	void rebuild_route_menu();
+	void save_routes();
+	void load_routes();
+	static std::string drops_as_json(const DropModel::Snapshot& drops, const std::vector<std::size_t>& row_order);
+	std::vector<std::size_t> export_order() const;
+	void init_session();
 	bool receive();
+	static bool parse_json_stats(const std::string& text, std::vector<std::array<int, 3>>& stats);
+	static bool parse_binary_stats(const std::string& text, std::vector<std::array<int, 3>>& stats);
 
 private slots:
 	void save();
 	void load();
 	void send();
 	void zoom();
+	void classify_screenshots();
 	void entry_button_action(bool checked, std::size_t row);
+	void new_route();
+	void delete_route();
+	void filter_view();
+	void sort_view();
+	void reset_view();
 
 public:
-	AppWindow();
+	AppWindow(const std::string& route = {});
 };
 
 }
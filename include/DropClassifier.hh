@@ -0,0 +1,70 @@
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtGui/QImage>
+
+#include <DropModel.hh>
+
+#ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_DROPCLASSIFIER_HH_
+#define INCLUDE_GENSHINARTIFACTSPAWNSTAT_DROPCLASSIFIER_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Detects the drop shown on an in-game result screenshot by matching one
+// grayscale template per drop type against a downscaled copy of the screenshot.
+//
+// The templates are not shipped: crop the drop icons from your own 1920 px wide
+// result screenshots and save them in TEMPLATE_DIR as
+//   single_one_star.png  - the icon row of a single one-star drop
+//   double_one_star.png  - the icon row of a double one-star drop (both icons)
+//   single_two_star.png  - the icon row of a single two-star drop
+// Crop all three at the same screen position and size.
+class DropClassifier {
+
+	// templates are cut from screenshots of this width
+	inline static constexpr int REFERENCE_WIDTH = 1920;
+	// screenshots are downscaled to this width before matching
+	inline static constexpr int WORK_WIDTH = 640;
+	// mean absolute gray value difference per pixel above which nothing matches
+	inline static constexpr int MAX_MEAN_DIFF = 24;
+	// the best template has to beat every other one by this much, otherwise the user decides
+	inline static constexpr int MIN_MARGIN = 4;
+
+	struct GrayImage {
+		int width = 0;
+		int height = 0;
+		std::vector<std::uint8_t> pixels;
+	};
+
+	std::array<GrayImage, 3> m_templates;
+	bool m_valid = false;
+
+	static GrayImage to_gray(const QImage&);
+	static std::uint32_t sad_row(const std::uint8_t* a, const std::uint8_t* b, int n);
+	static std::uint64_t best_match(const GrayImage& image, const GrayImage& templ, std::uint64_t bound);
+
+public:
+	inline static constexpr auto TEMPLATE_DIR = "classifier/";
+
+	DropClassifier();
+	bool valid() const;
+	Drop classify(const QImage& screenshot) const;
+	Drop classify(const QString& screenshot_file) const;
+};
+
+// QtConcurrent::mapped functor, shares one classifier across the pool
+struct ClassifyScreenshot {
+	using result_type = Drop;
+
+	std::shared_ptr<const DropClassifier> classifier;
+
+	Drop operator()(const QString& screenshot_file) const;
+};
+
+}
+
+#endif
\ No newline at end of file
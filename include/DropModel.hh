@@ -0,0 +1,43 @@
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include <QtCore/QObject>
+
+#ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_DROPMODEL_HH_
+#define INCLUDE_GENSHINARTIFACTSPAWNSTAT_DROPMODEL_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+enum class Drop : std::uint8_t {
+	None,
+	SingleOneStar,
+	DoubleOneStar,
+	SingleTwoStar
+};
+
+// The selected drop of every spot, one byte per spot. Widgets only display it.
+class DropModel : public QObject {
+	Q_OBJECT
+
+	std::vector<std::uint8_t> m_drops;
+
+public:
+	// immutable copy, safe to read from any thread
+	using Snapshot = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+	void resize(std::size_t rows);
+	std::size_t size() const;
+	Drop drop(std::size_t row) const;
+	void set_drop(std::size_t row, Drop);
+	void reset();
+	Snapshot snapshot() const;
+
+signals:
+	void drop_changed(std::size_t row);
+	void drops_reset();
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -1,30 +1,66 @@
 #include <vector>
+#include <deque>
+#include <unordered_map>
 
 #include <QtCore/QObject>
 #include <QtCore/QEvent>
+#include <QtGui/QKeyEvent>
 #include <QtWidgets/QWidget>
 #include <QtWidgets/QScrollArea>
 
+#include <DropModel.hh>
+#include <InputLatency.hh>
+
 #ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_DROPSELECTHANDLER_HH_
 #define INCLUDE_GENSHINARTIFACTSPAWNSTAT_DROPSELECTHANDLER_HH_
 
 namespace GenshinArtifactSpawnStat {
 
+// Type-ahead drop entry along a route: keys are queued as they arrive and
+// applied in order at the route cursor, not at whichever widget has focus.
+// Focus & scrolling follow the cursor once per drained batch.
 class DropSelectHandler : public QObject {
 	Q_OBJECT
 
+	struct PendingKey {
+		int key;
+		InputLatency::Stamp received;
+	};
+
 	std::vector<QWidget*> m_focus_chain;
+	std::vector<std::size_t> m_rows; // model row of each chain position
+	std::unordered_map<const QWidget*, std::size_t> m_chain_index;
 	QScrollArea* m_focus_chain_container;
+	DropModel& m_drops;
+	InputLatency& m_latency;
+
+	std::size_t m_cursor = 0;
+	bool m_at_end = false; // last spot already set, further drops overwrite it
+	std::deque<PendingKey> m_pending;
+	bool m_drain_scheduled = false;
+	bool m_moving_focus = false;
+	bool m_attached = false;
+	QMetaObject::Connection m_focus_connection;
 
 	bool check_focus(const QWidget*) const;
 	std::size_t focus_index() const;
-	bool valid_focus_index(std::size_t) const;
-	void focus_next();
-	void focus_prev();
-	void set_focus(QWidget*);
+	std::size_t chain_index(const QWidget*) const;
+	bool inside_container(const QObject*) const;
+	void enqueue(const QKeyEvent*);
+	void drain();
+	bool apply_pending();
+	InputLatency::Outcome apply_drop(Drop);
+	InputLatency::Outcome move_cursor(int step);
+	void set_cursor(std::size_t);
+	void sync_focus();
+	void focus_changed(QWidget* old, QWidget* now);
 
 public:
-	DropSelectHandler(std::vector<QWidget*> focus_chain, QScrollArea* focus_chain_container);
+	DropSelectHandler(std::vector<QWidget*> focus_chain, std::vector<std::size_t> rows, QScrollArea* focus_chain_container, DropModel& drops, InputLatency& latency);
+	~DropSelectHandler();
+
+	void attach();
+	void detach();
 	bool eventFilter(QObject*, QEvent*) override;
 };
 
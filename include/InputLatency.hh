@@ -0,0 +1,56 @@
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_INPUTLATENCY_HH_
+#define INCLUDE_GENSHINARTIFACTSPAWNSTAT_INPUTLATENCY_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Key-to-handled latency of the drop entry keys, GUI thread only.
+// A key starts at its window system timestamp, mapped onto the steady clock by the
+// smallest offset seen so far, so the time a key waits behind painting & scrolling
+// before Qt dispatches it is included. Every received key ends up in one outcome,
+// otherwise input got lost.
+class InputLatency {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class Outcome {
+		Applied,     // changed the drop at a valid cursor
+		Overwritten, // cursor already past the end of the chain, last spot set again
+		Ignored,     // no spot at the cursor, drop already selected or cursor at the chain's end
+		Moved        // cursor moved up/down
+	};
+
+	struct Stamp {
+		Clock::time_point dispatched;
+		std::int64_t offset_ms = 0; // dispatched - window system timestamp
+		bool has_timestamp = false;
+	};
+
+private:
+	struct Sample {
+		std::int64_t offset_ms;
+		bool has_timestamp;
+		std::uint32_t queued_us;
+	};
+
+	std::vector<Sample> m_samples;
+	std::int64_t m_min_offset_ms = std::numeric_limits<std::int64_t>::max();
+	std::uint64_t m_received = 0;
+	std::array<std::uint64_t, 4> m_outcomes{};
+
+public:
+	// event_timestamp_ms of 0 means the platform didn't stamp the key
+	Stamp received(unsigned long event_timestamp_ms);
+	void handled(const Stamp&, Outcome);
+	std::string summary() const;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <QtGui/QPixmap>
 #include <QtGui/QKeyEvent>
 
+#include <DropModel.hh>
+
 #ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_INVESTIGATIONENTRY_HH_
 #define INCLUDE_GENSHINARTIFACTSPAWNSTAT_INVESTIGATIONENTRY_HH_
 
@@ -27,6 +29,8 @@ class InvestigationEntry : public QFrame {
 	QRadioButton* m_1_one_star_button;
 	QRadioButton* m_2_one_star_button;
 	QRadioButton* m_1_two_star_button;
+	DropModel& m_drops;
+	std::size_t m_row;
 
 	void load_images(const QString& map_path, const QString& screenshot_path);
 	void init_drop_choice_box();
@@ -35,16 +39,12 @@ protected:
 	void keyPressEvent(QKeyEvent*) override;
 
 public:
-	InvestigationEntry(const QString& map_path, const QString& screenshot_path);
-
-	enum class Drop {
-		None,
-		SingleOneStar,
-		DoubleOneStar,
-		SingleTwoStar
-	};
+	InvestigationEntry(const QString& map_path, const QString& screenshot_path, DropModel& drops, std::size_t row);
+
+	using Drop = GenshinArtifactSpawnStat::Drop;
 	Drop drop() const;
 	void set_drop(Drop);
+	void sync_drop(); // show the model's drop
 	void zoom(double factor);
 	void enable_choice(bool);
 	void set_stats(int single_one_star_drops, int double_one_star_drops, int single_two_star_drops);
@@ -0,0 +1,51 @@
+#include <vector>
+
+#include <QtCore/QRect>
+#include <QtCore/QSize>
+#include <QtWidgets/QLayout>
+#include <QtWidgets/QLayoutItem>
+#include <QtWidgets/QWidget>
+
+#ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_ROUTELAYOUT_HH_
+#define INCLUDE_GENSHINARTIFACTSPAWNSTAT_ROUTELAYOUT_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Rows of (button, entry) stacked in a given order. Changing the order or the
+// set of shown rows only repositions the existing items - nothing is re-added.
+class RouteLayout : public QLayout {
+	Q_OBJECT
+
+	std::vector<QLayoutItem*> m_items; // button, entry, button, entry, ...
+	std::vector<std::size_t> m_order;
+	int m_column_spacing;
+	mutable QSize m_size_hint;
+
+	std::size_t row_count() const;
+	QLayoutItem* button_item(std::size_t row) const;
+	QLayoutItem* entry_item(std::size_t row) const;
+	int row_height(std::size_t row) const;
+
+public:
+	RouteLayout(int column_spacing);
+	~RouteLayout();
+
+	void add_row(QWidget* button, QWidget* entry);
+	// shows exactly the rows in order, top to bottom
+	void set_order(const std::vector<std::size_t>& order);
+	const std::vector<std::size_t>& order() const;
+
+	void addItem(QLayoutItem*) override; // items pair up as (button, entry) rows
+	int count() const override;
+	QLayoutItem* itemAt(int) const override;
+	QLayoutItem* takeAt(int) override;
+	Qt::Orientations expandingDirections() const override;
+	QSize sizeHint() const override;
+	QSize minimumSize() const override;
+	void setGeometry(const QRect&) override;
+	void invalidate() override;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include <vector>
+#include <array>
+#include <set>
+#include <utility>
+#include <optional>
+
+#ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_SPOTSTATSINDEX_HH_
+#define INCLUDE_GENSHINARTIFACTSPAWNSTAT_SPOTSTATSINDEX_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Per-spot statistics with one sorted index per metric, updated in O(log n)
+// per spot so filtering & sorting never has to re-sort or re-parse anything.
+class SpotStatsIndex {
+public:
+	enum class Metric {
+		Records,
+		AvgExp,
+		SingleOneStarRate,
+		DoubleOneStarRate,
+		SingleTwoStarRate
+	};
+	inline static constexpr std::size_t METRIC_COUNT = 5;
+	static const char* metric_name(Metric);
+
+	struct View {
+		std::optional<Metric> filter_metric;
+		double min_value = 0.0;
+		std::optional<Metric> sort_metric;
+		bool descending = true;
+
+		bool active() const;
+	};
+
+private:
+	using Key = std::pair<double, std::size_t>; // metric value, row
+
+	std::vector<std::array<double, METRIC_COUNT>> m_values;
+	std::array<std::set<Key>, METRIC_COUNT> m_indexes;
+
+public:
+	void resize(std::size_t rows);
+	void update(std::size_t row, int single_one_star_drops, int double_one_star_drops, int single_two_star_drops);
+	double value(std::size_t row, Metric) const;
+
+	// rows passing the view's filter, in view order (or in the given order if unsorted)
+	std::vector<std::size_t> apply(const View&, const std::vector<std::size_t>& rows) const;
+};
+
+}
+
+#endif
\ No newline at end of file
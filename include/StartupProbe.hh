@@ -0,0 +1,26 @@
+#include <functional>
+#include <utility>
+
+#ifndef INCLUDE_GENSHINARTIFACTSPAWNSTAT_STARTUPPROBE_HH_
+#define INCLUDE_GENSHINARTIFACTSPAWNSTAT_STARTUPPROBE_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Marks the end of startup phases for benchmarks; does nothing unless an observer is set.
+class StartupProbe {
+
+	inline static std::function<void(const char* phase)> m_observer;
+
+public:
+	static void observe(std::function<void(const char* phase)> observer) {
+		m_observer = std::move(observer);
+	}
+
+	static void mark(const char* phase) {
+		if (m_observer) m_observer(phase);
+	}
+};
+
+}
+
+#endif
\ No newline at end of file
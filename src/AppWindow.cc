@@ -6,17 +6,24 @@
 #include <cmath>
 #include <iterator>
 #include <algorithm>
+#include <numeric>
 #include <array>
+#include <cstdint>
 
 #include <QtCore/QSignalBlocker>
+#include <QtCore/QDir>
+#include <QtCore/QFutureWatcher>
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtWidgets/QMenuBar>
 #include <QtWidgets/QWidget>
 #include <QtWidgets/QScrollBar>
 #include <QtWidgets/QProgressDialog>
 #include <QtWidgets/QInputDialog>
+#include <QtWidgets/QLineEdit>
 #include <QtWidgets/QLayoutItem>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
+#include <QtWidgets/QApplication>
 #include <cpr/cpr.h>
 #include <rapidjson/document.h>
 #include <rapidjson/istreamwrapper.h>
@@ -24,37 +31,53 @@
 #include <rapidjson/writer.h>
 
 #include <AppWindow.hh>
+#include <StartupProbe.hh>
 
 namespace GenshinArtifactSpawnStat {
 
-AppWindow::AppWindow() {
+AppWindow::AppWindow(const std::string& route) {
 	setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Preferred);
 	create_menu();
 	create_entries();
+	m_stats_index.resize(m_entries.size());
+	StartupProbe::mark("images_loaded");
 
 	m_central = new QScrollArea{};
 	auto* main = new QWidget{};
-	m_layout = new QGridLayout{};
+	m_layout = new RouteLayout{ SPACING };
 	m_layout->setContentsMargins(0, 0, 0, 0);
-	m_layout->setColumnMinimumWidth(1, SPACING);
 
-	for (std::size_t i = 0; i < m_entries.size(); i++) {
-		m_layout->addWidget(m_entry_buttons[i], i, 0);
-		m_layout->addWidget(m_entries[i], i, 2);
-	}
+	for (std::size_t i = 0; i < m_entries.size(); i++)
+		m_layout->add_row(m_entry_buttons[i], m_entries[i]);
 	main->setLayout(m_layout);
 	m_central->setWidgetResizable(true);
 	m_central->setWidget(main);
 	setCentralWidget(m_central);
 
-	install_keyboard_navigation();
+	// entries display m_drops; a reset is repainted once for all of them
+	connect(&m_drops, &DropModel::drop_changed, this, [this](std::size_t row) {
+		m_entries.at(row)->sync_drop();
+	});
+	connect(&m_drops, &DropModel::drops_reset, this, [this]() {
+		m_central->setUpdatesEnabled(false);
+		for (auto* e : m_entries)
+			e->sync_drop();
+		m_central->setUpdatesEnabled(true);
+	});
 
 	update_max_width();
 	resize(maximumWidth(), 1000);
 	show();
+	StartupProbe::mark("shown");
 
+	init_session();
 	receive();
-	load_route();
+	StartupProbe::mark("stats_received");
+	load_routes();
+	if (!route.empty() && m_routes.count(route) == 0)
+		QMessageBox::warning(this, "Unknown route", QString::fromStdString("There is no route named '" + route + "'."));
+	select_route(m_routes.count(route) > 0 ? route : m_routes.begin()->first);
+	StartupProbe::mark("route_loaded");
 }
 
 void AppWindow::create_menu() {
@@ -70,13 +93,14 @@ void AppWindow::create_menu() {
 
 	m_save_route_action = new QAction{ "&Confirm route" };
 	connect(m_save_route_action, &QAction::triggered, this, [this]() {
-		if (std::filesystem::exists(ROUTE_FILE)) {
-			auto ans = QMessageBox::question(this, "Overwrite route?", "Route file 'route.dat' already exists. Overwrite?");
-			if (ans == QMessageBox::Yes) {
-				route_mode(false);
-				save_route();
-			}
+		if (!m_routes[m_current_route].row_order.empty()) {
+			auto ans = QMessageBox::question(this, "Overwrite route?",
+			  QString::fromStdString("Route '" + m_current_route + "' already exists. Overwrite?"));
+			if (ans != QMessageBox::Yes) return;
 		}
+		m_routes[m_current_route].row_order = m_row_order;
+		route_mode(false);
+		save_routes();
 	});
 	m_save_route_action->setEnabled(false);
 
@@ -88,6 +112,29 @@ void AppWindow::create_menu() {
 	m_zoom_action = new QAction{ "&Zoom images" };
 	connect(m_zoom_action, &QAction::triggered, this, &AppWindow::zoom);
 
+	m_classify_action = new QAction{ "&Classify screenshots" };
+	connect(m_classify_action, &QAction::triggered, this, &AppWindow::classify_screenshots);
+
+	m_new_route_action = new QAction{ "&New route" };
+	connect(m_new_route_action, &QAction::triggered, this, &AppWindow::new_route);
+
+	m_delete_route_action = new QAction{ "&Delete route" };
+	connect(m_delete_route_action, &QAction::triggered, this, &AppWindow::delete_route);
+
+	m_filter_action = new QAction{ "&Filter spots" };
+	connect(m_filter_action, &QAction::triggered, this, &AppWindow::filter_view);
+
+	m_sort_action = new QAction{ "&Sort spots" };
+	connect(m_sort_action, &QAction::triggered, this, &AppWindow::sort_view);
+
+	m_reset_view_action = new QAction{ "&Reset view" };
+	connect(m_reset_view_action, &QAction::triggered, this, &AppWindow::reset_view);
+
+	m_input_latency_action = new QAction{ "&Input latency" };
+	connect(m_input_latency_action, &QAction::triggered, this, [this]() {
+		QMessageBox::information(this, "Input latency", QString::fromStdString(m_input_latency.summary()));
+	});
+
 	m_file_menu = menuBar()->addMenu("&File");
 	m_file_menu->addAction(m_load_action);
 	m_file_menu->addAction(m_save_action);
@@ -95,8 +142,17 @@ void AppWindow::create_menu() {
 	m_edit_menu = menuBar()->addMenu("&Edit");
 	m_edit_menu->addAction(m_edit_route_action);
 	m_edit_menu->addAction(m_save_route_action);
+	m_route_menu = m_edit_menu->addMenu("&Routes");
+	m_route_group = new QActionGroup{ m_route_menu };
+	m_edit_menu->addAction(m_classify_action);
 	m_edit_menu->addSeparator();
 	m_edit_menu->addAction(m_zoom_action);
+	m_view_menu = menuBar()->addMenu("&View");
+	m_view_menu->addAction(m_filter_action);
+	m_view_menu->addAction(m_sort_action);
+	m_view_menu->addAction(m_reset_view_action);
+	m_view_menu->addSeparator();
+	m_view_menu->addAction(m_input_latency_action);
 }
 
 void AppWindow::create_entries() {
@@ -138,7 +194,8 @@ void AppWindow::create_entries() {
 }
 
 void AppWindow::add_entry(const QString& map_file, const QString& spot_file) {
-	auto* entry = new InvestigationEntry{ map_file, spot_file };
+	m_drops.resize(m_entries.size() + 1);
+	auto* entry = new InvestigationEntry{ map_file, spot_file, m_drops, m_entries.size() };
 	m_entries.push_back(entry);
 }
 
@@ -156,26 +213,26 @@ void AppWindow::add_entry_button() {
 	m_entry_buttons.push_back(entry_button);
 }
 
-std::string AppWindow::drops_as_json() const {
+std::string AppWindow::drops_as_json(const DropModel::Snapshot& drops, const std::vector<std::size_t>& row_order) {
 	namespace rj = rapidjson;
 	rj::Document json{ rj::kArrayType };
 
-	for (auto row : m_row_order) {
+	for (auto row : row_order) {
 		rj::Value row_json{ rj::kArrayType };
 		row_json.PushBack(row, json.GetAllocator());
 		int drop_id = -1;
 
-		switch (m_entries.at(row)->drop()) {
-			case InvestigationEntry::Drop::SingleOneStar:
+		switch (static_cast<Drop>(drops->at(row))) {
+			case Drop::SingleOneStar:
 				drop_id = 0;
 				break;
-			case InvestigationEntry::Drop::DoubleOneStar:
+			case Drop::DoubleOneStar:
 				drop_id = 1;
 				break;
-			case InvestigationEntry::Drop::SingleTwoStar:
+			case Drop::SingleTwoStar:
 				drop_id = 2;
 				break;
-			case InvestigationEntry::Drop::None:
+			case Drop::None:
 				drop_id = -1;
 				break;
 		}
@@ -194,14 +251,25 @@ std::string AppWindow::drops_as_json() const {
 void AppWindow::save() {
 	auto save_file = QFileDialog::getSaveFileName(this, "Save", "", "*.dat");
 	if (!save_file.isNull())
-		std::ofstream{ save_file.toStdString() } << drops_as_json();
+		std::ofstream{ save_file.toStdString() } << drops_as_json(m_drops.snapshot(), export_order());
+}
+
+std::vector<std::size_t> AppWindow::export_order() const {
+	// current route first, then drops entered while following other routes
+	auto order = m_row_order;
+	std::vector<char> listed(m_drops.size(), 0);
+	for (auto row : order)
+		listed[row] = 1;
+	for (std::size_t row = 0; row < listed.size(); ++row)
+		if (!listed[row]) order.push_back(row);
+	return order;
 }
 
 void AppWindow::load() {
-	static const std::array<InvestigationEntry::Drop, 3> drop_dict{
-		InvestigationEntry::Drop::SingleOneStar,
-		InvestigationEntry::Drop::DoubleOneStar,
-		InvestigationEntry::Drop::SingleTwoStar
+	static const std::array<Drop, 3> drop_dict{
+		Drop::SingleOneStar,
+		Drop::DoubleOneStar,
+		Drop::SingleTwoStar
 	};
 
 	auto save_file = QFileDialog::getOpenFileName(this, "Load", "", "*.dat");
@@ -222,22 +290,21 @@ void AppWindow::load() {
 	}
 
 	// input ok -> can modify without errors
-	m_row_order.clear();
+	// the loaded order is only shown, it replaces the route on disk once confirmed
 	route_mode(true);
 	for (const auto& drop_arr : json.GetArray()) {
 		const auto& row = drop_arr[0].GetInt();
 		const auto& drop = drop_arr[1].GetInt();
 		m_row_order.push_back(row);
-		m_entries.at(row)->set_drop(drop_dict[drop]);
+		m_drops.set_drop(row, drop_dict[drop]);
 	}
 	route_mode(false);
 }
 
 void AppWindow::send() {
-	cpr::Response res = cpr::Post(
-	  cpr::Url{ HOST },
-	  cpr::Body{ "{\"drops\":" + drops_as_json() + "}" },
-	  cpr::Header{ { "Content-Type", "application/json" } });
+	m_session.SetBody(cpr::Body{ "{\"drops\":" + drops_as_json(m_drops.snapshot(), export_order()) + "}" });
+	m_session.SetHeader(cpr::Header{ { "Content-Type", "application/json" } });
+	cpr::Response res = m_session.Post();
 
 	rapidjson::Document json;
 	json.Parse(res.text.c_str());
@@ -249,8 +316,7 @@ void AppWindow::send() {
 		QMessageBox::information(this, "Upload successful",
 		  "Your drops have been uploaded. Your selection will be reset.");
 
-		for (auto* entry : m_entries)
-			entry->set_drop(InvestigationEntry::Drop::None);
+		m_drops.reset();
 	} else {
 		QMessageBox::warning(this, "Upload failed",
 		  "Failed to upload your drops. Go to 'File > Save' or 'File > Load' to save/load your selection and try again later.");
@@ -269,6 +335,65 @@ void AppWindow::zoom() {
 	resize(maximumWidth(), size().height());
 }
 
+void AppWindow::classify_screenshots() {
+	auto classifier = std::make_shared<const DropClassifier>();
+	if (!classifier->valid()) {
+		QMessageBox::warning(this, "Classification failed",
+		  QString{ "Missing drop templates in '" } + DropClassifier::TEMPLATE_DIR + "'.\n"
+			"Crop the drop icons from your own 1920 px wide result screenshots and save them as "
+			"single_one_star.png, double_one_star.png and single_two_star.png.");
+		return;
+	}
+
+	auto screenshot_dir = QFileDialog::getExistingDirectory(this, "Screenshot folder");
+	if (screenshot_dir.isNull()) return;
+
+	// screenshots are taken while following the route -> i-th screenshot belongs to i-th route row
+	QStringList screenshot_files;
+	const auto screenshot_names = QDir{ screenshot_dir }.entryList({ "*.png", "*.jpg", "*.jpeg", "*.bmp" }, QDir::Files, QDir::Name);
+	for (const auto& name : screenshot_names)
+		screenshot_files.push_back(QDir{ screenshot_dir }.filePath(name));
+
+	// one missing or extra screenshot would shift every later spot
+	if (static_cast<std::size_t>(screenshot_files.size()) != m_row_order.size()) {
+		QMessageBox::warning(this, "Classification failed",
+		  QString{ "Found %1 screenshots for the %2 spots of route '%3'. Take exactly one screenshot per spot." }
+			.arg(screenshot_files.size())
+			.arg(m_row_order.size())
+			.arg(QString::fromStdString(m_current_route)));
+		return;
+	}
+	if (screenshot_files.isEmpty()) return;
+
+	auto* progress = new QProgressDialog{ "Classifying screenshots ...", "Cancel", 0, screenshot_files.size(), this };
+	progress->setWindowModality(Qt::WindowModal);
+	progress->setMinimumWidth(500);
+	progress->setMinimumDuration(0);
+
+	auto* watcher = new QFutureWatcher<Drop>{ this };
+	connect(watcher, &QFutureWatcherBase::progressValueChanged, progress, &QProgressDialog::setValue);
+	connect(progress, &QProgressDialog::canceled, watcher, &QFutureWatcherBase::cancel);
+	connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, progress, rows = m_row_order]() {
+		progress->deleteLater();
+		watcher->deleteLater();
+		if (watcher->isCanceled()) return;
+
+		int classified = 0;
+		const auto drops = watcher->future().results();
+		for (int i = 0; i < drops.size(); ++i) {
+			if (drops[i] == Drop::None) continue;
+			m_drops.set_drop(rows[i], drops[i]);
+			classified++;
+		}
+
+		QMessageBox::information(this, "Classification done",
+		  QString{ "Classified %1 of %2 screenshots. Please check the selection before sending." }
+			.arg(classified)
+			.arg(drops.size()));
+	});
+	watcher->setFuture(QtConcurrent::mapped(screenshot_files, ClassifyScreenshot{ classifier }));
+}
+
 void AppWindow::update_max_width() {
 	int max_entry_width = 0;
 	for (const auto* e : m_entries)
@@ -281,10 +406,19 @@ void AppWindow::route_mode(bool activate) {
 	if (activate) {
 		m_row_order.clear();
 		remove_keyboard_navigation();
+		remove_view_navigation();
+
+		// every spot is selectable while editing
+		std::vector<std::size_t> all_rows(m_entries.size());
+		std::iota(all_rows.begin(), all_rows.end(), 0);
+		m_layout->set_order(all_rows);
 	}
 
 	m_edit_route_action->setEnabled(!activate);
 	m_save_route_action->setEnabled(activate);
+	m_route_menu->setEnabled(!activate);
+	m_view_menu->setEnabled(!activate);
+	m_classify_action->setEnabled(!activate); // the route is being rebuilt
 	for (auto* e : m_entries)
 		e->enable_choice(!activate);
 
@@ -294,21 +428,8 @@ void AppWindow::route_mode(bool activate) {
 		m_entry_buttons[i]->setChecked(false);
 	}
 
-	if (!activate) {
-		while (auto* item = m_layout->takeAt(0))
-			item->widget()->hide();
-
-		for (std::size_t i = 0; i < m_row_order.size(); i++) {
-			auto row = m_row_order[i];
-
-			m_layout->addWidget(m_entry_buttons[row], i, 0);
-			m_layout->addWidget(m_entries[row], i, 2);
-			m_entry_buttons[row]->show();
-			m_entries[row]->show();
-		}
-
-		install_keyboard_navigation();
-	}
+	if (!activate)
+		show_rows();
 }
 
 void AppWindow::entry_button_action(bool checked, std::size_t row) {
@@ -320,49 +441,221 @@ void AppWindow::entry_button_action(bool checked, std::size_t row) {
 }
 
 void AppWindow::install_keyboard_navigation() {
-	if (m_selecthandler != nullptr) return;
+	auto& navigation = m_routes[m_current_route].navigation;
+	if (navigation == nullptr) {
+		std::vector<QWidget*> navigation_order;
+		for (std::size_t row : m_row_order)
+			navigation_order.push_back(m_entries[row]);
+		navigation = std::make_unique<DropSelectHandler>(navigation_order, m_row_order, m_central, m_drops, m_input_latency);
+	}
+	navigation->attach();
+}
+
+void AppWindow::remove_keyboard_navigation() {
+	auto& navigation = m_routes[m_current_route].navigation;
+	if (navigation == nullptr) return;
+	navigation->detach();
+	navigation.reset();
+}
+
+void AppWindow::remove_view_navigation() {
+	if (m_view_navigation == nullptr) return;
+	m_view_navigation->detach();
+	m_view_navigation.reset();
+}
+
+void AppWindow::show_rows() {
+	remove_view_navigation();
+	if (!m_view.active()) {
+		m_layout->set_order(m_row_order);
+		install_keyboard_navigation();
+		return;
+	}
+
+	const auto rows = m_stats_index.apply(m_view, m_row_order);
+	m_layout->set_order(rows);
 
+	// navigate the shown rows only, the route's own chain stays cached
+	if (const auto& navigation = m_routes[m_current_route].navigation)
+		navigation->detach();
 	std::vector<QWidget*> navigation_order;
-	for (std::size_t row : m_row_order)
+	for (auto row : rows)
 		navigation_order.push_back(m_entries[row]);
+	m_view_navigation = std::make_unique<DropSelectHandler>(navigation_order, rows, m_central, m_drops, m_input_latency);
+	m_view_navigation->attach();
+}
 
-	m_selecthandler = new DropSelectHandler{ navigation_order, m_central };
-	m_central->installEventFilter(m_selecthandler);
+QStringList AppWindow::metric_names() {
+	QStringList names;
+	for (std::size_t m = 0; m < SpotStatsIndex::METRIC_COUNT; ++m)
+		names.push_back(SpotStatsIndex::metric_name(static_cast<SpotStatsIndex::Metric>(m)));
+	return names;
 }
 
-void AppWindow::remove_keyboard_navigation() {
-	if (m_selecthandler == nullptr) return;
-	m_central->removeEventFilter(m_selecthandler);
-	delete m_selecthandler;
-	m_selecthandler = nullptr;
+void AppWindow::filter_view() {
+	const auto metrics = metric_names();
+	bool confirm = false;
+	const auto metric = QInputDialog::getItem(this, "Filter spots", "Show spots by", metrics, 0, false, &confirm);
+	if (!confirm) return;
+	const auto min_value = QInputDialog::getDouble(this, "Filter spots", metric + " at least", 0.0, 0.0, 1e9, 2, &confirm);
+	if (!confirm) return;
+
+	m_view.filter_metric = static_cast<SpotStatsIndex::Metric>(metrics.indexOf(metric));
+	m_view.min_value = min_value;
+	show_rows();
 }
 
-void AppWindow::save_route() const {
-	std::ofstream route_ofs{ ROUTE_FILE };
-	for (auto row : m_row_order)
-		route_ofs << row << " ";
+void AppWindow::sort_view() {
+	const auto metrics = metric_names();
+	const QStringList directions{ "Descending", "Ascending" };
+	bool confirm = false;
+	const auto metric = QInputDialog::getItem(this, "Sort spots", "Sort spots by", metrics, 0, false, &confirm);
+	if (!confirm) return;
+	const auto direction = QInputDialog::getItem(this, "Sort spots", "Order", directions, 0, false, &confirm);
+	if (!confirm) return;
+
+	m_view.sort_metric = static_cast<SpotStatsIndex::Metric>(metrics.indexOf(metric));
+	m_view.descending = direction == directions[0];
+	show_rows();
+}
+
+void AppWindow::reset_view() {
+	m_view = {};
+	show_rows();
 }
 
-void AppWindow::load_route() {
-	if (!std::filesystem::is_regular_file(ROUTE_FILE)) return;
+void AppWindow::select_route(const std::string& name) {
+	if (name == m_current_route || m_routes.count(name) == 0) return;
+
+	// park the current route with its navigation chain for switching back later
+	if (m_routes.count(m_current_route) > 0) {
+		auto& current = m_routes[m_current_route];
+		if (current.navigation != nullptr) current.navigation->detach();
+		// unconfirmed order, e.g. from a loaded drop file -> its chain isn't the route's
+		if (m_row_order != current.row_order) current.navigation.reset();
+	}
+
+	m_current_route = name;
+	m_row_order = m_routes[name].row_order;
+	show_rows();
+	rebuild_route_menu();
+}
+
+void AppWindow::rebuild_route_menu() {
+	m_route_menu->clear();
+	for (const auto& [name, route] : m_routes) {
+		auto* action = m_route_menu->addAction(QString::fromStdString(name));
+		action->setCheckable(true);
+		action->setChecked(name == m_current_route);
+		action->setActionGroup(m_route_group);
+		connect(action, &QAction::triggered, this, [this, name = name]() {
+			select_route(name);
+		});
+	}
+	m_route_menu->addSeparator();
+	m_route_menu->addAction(m_new_route_action);
+	m_route_menu->addAction(m_delete_route_action);
+	m_delete_route_action->setEnabled(m_routes.size() > 1);
+}
+
+void AppWindow::new_route() {
+	bool confirm = false;
+	const auto name = QInputDialog::getText(this, "New route", "Name", QLineEdit::Normal, QString{}, &confirm)
+						.trimmed()
+						.toStdString();
+	if (!confirm || name.empty()) return;
+	if (name.find('\t') != std::string::npos || m_routes.count(name) > 0) {
+		QMessageBox::warning(this, "Invalid name", "Route names must be unique and must not contain tabs.");
+		return;
+	}
+
+	m_routes[name];
+	select_route(name);
 	route_mode(true);
+}
 
-	std::ifstream route_ifs{ ROUTE_FILE };
-	std::size_t row = 0;
-	while (route_ifs >> row)
-		if (row < m_entries.size())
-			m_row_order.push_back(row);
+void AppWindow::delete_route() {
+	if (m_routes.size() <= 1) return;
+	auto ans = QMessageBox::question(this, "Delete route?",
+	  QString::fromStdString("Delete route '" + m_current_route + "'?"));
+	if (ans != QMessageBox::Yes) return;
+
+	remove_keyboard_navigation();
+	m_routes.erase(m_current_route);
+	m_current_route.clear();
+	select_route(m_routes.begin()->first);
+	save_routes();
+}
 
-	route_mode(false);
+void AppWindow::save_routes() {
+	std::ofstream routes_ofs{ ROUTES_FILE };
+	for (const auto& [name, route] : m_routes) {
+		routes_ofs << name << '\t';
+		for (auto row : route.row_order)
+			routes_ofs << row << " ";
+		routes_ofs << '\n';
+	}
+}
+
+void AppWindow::load_routes() {
+	auto read_rows = [this](std::istream& is, std::vector<std::size_t>& row_order) {
+		std::size_t row = 0;
+		while (is >> row)
+			if (row < m_entries.size())
+				row_order.push_back(row);
+	};
+
+	// one route per line: <name>\t<row> <row> ...
+	std::ifstream routes_ifs{ ROUTES_FILE };
+	std::string line;
+	while (std::getline(routes_ifs, line)) {
+		const auto tab = line.find('\t');
+		if (tab == std::string::npos || tab == 0) continue;
+		std::istringstream rows_iss{ line.substr(tab + 1) };
+		read_rows(rows_iss, m_routes[line.substr(0, tab)].row_order);
+	}
+
+	// single route file of older versions
+	if (m_routes.empty() && std::filesystem::is_regular_file(ROUTE_FILE)) {
+		std::ifstream route_ifs{ ROUTE_FILE };
+		read_rows(route_ifs, m_routes[DEFAULT_ROUTE].row_order);
+	}
+
+	// no route yet -> every spot in file order
+	if (m_routes.empty())
+		m_routes[DEFAULT_ROUTE].row_order = m_row_order;
+}
+
+void AppWindow::init_session() {
+	m_session.SetUrl(cpr::Url{ HOST });
+	auto curl = m_session.GetCurlHolder();
+	curl_easy_setopt(curl->handle, CURLOPT_ACCEPT_ENCODING, ""); // all encodings built into curl, e.g. gzip & deflate
+	curl_easy_setopt(curl->handle, CURLOPT_TCP_KEEPALIVE, 1L);
 }
 
 bool AppWindow::receive() {
-	cpr::Response res = cpr::Get(cpr::Url{ HOST });
+	m_session.SetHeader(cpr::Header{ { "Accept", std::string{ STATS_BINARY_TYPE } + ", application/json;q=0.9" } });
+	cpr::Response res = m_session.Get();
 	if (res.status_code != 200) return false;
 
+	std::vector<std::array<int, 3>> stats;
+	const bool binary = res.header["Content-Type"].rfind(STATS_BINARY_TYPE, 0) == 0;
+	if (!(binary ? parse_binary_stats(res.text, stats) : parse_json_stats(res.text, stats)))
+		return false;
+
+	for (std::size_t i = 0; i < stats.size() && i < m_entries.size(); ++i) {
+		m_entries[i]->set_stats(stats[i][0], stats[i][1], stats[i][2]);
+		m_stats_index.update(i, stats[i][0], stats[i][1], stats[i][2]);
+	}
+	if (m_view.active()) show_rows();
+	return true;
+}
+
+bool AppWindow::parse_json_stats(const std::string& text, std::vector<std::array<int, 3>>& stats) {
 	rapidjson::Document json;
-	json.Parse(res.text.c_str());
+	json.Parse(text.c_str(), text.size());
 	if (!(
+		  json.IsObject() &&
 		  json.HasMember("error") &&
 		  json["error"].IsBool() &&
 		  !json["error"].GetBool() &&
@@ -378,13 +671,29 @@ bool AppWindow::receive() {
 			if (!num.IsInt()) return false;
 	}
 
-	for (std::size_t i = 0; i < drops.Size() && i < m_entries.size(); ++i) {
-		const auto& drop_arr = drops[i].GetArray();
-		m_entries[i]->set_stats(
-		  drop_arr[0].GetInt(),
-		  drop_arr[1].GetInt(),
-		  drop_arr[2].GetInt());
-	}
+	stats.clear();
+	stats.reserve(drops.Size());
+	for (const auto& drop_arr : drops.GetArray())
+		stats.push_back({ drop_arr[0].GetInt(), drop_arr[1].GetInt(), drop_arr[2].GetInt() });
+	return true;
+}
+
+bool AppWindow::parse_binary_stats(const std::string& text, std::vector<std::array<int, 3>>& stats) {
+	// packed little-endian int32 triples
+	constexpr std::size_t TRIPLE_SIZE = 3 * 4;
+	if (text.size() % TRIPLE_SIZE != 0) return false;
+
+	auto read_int32 = [&text](std::size_t pos) {
+		std::uint32_t u = 0;
+		for (std::size_t b = 0; b < 4; ++b)
+			u |= static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos + b])) << (8 * b);
+		return static_cast<std::int32_t>(u);
+	};
+
+	stats.resize(text.size() / TRIPLE_SIZE);
+	for (std::size_t i = 0; i < stats.size(); ++i)
+		for (std::size_t j = 0; j < 3; ++j)
+			stats[i][j] = read_int32(i * TRIPLE_SIZE + j * 4);
 	return true;
 }
 
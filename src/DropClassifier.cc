@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <cstdlib>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GENSHINARTIFACTSPAWNSTAT_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <QtGui/QImageReader>
+
+#include <DropClassifier.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+namespace {
+
+constexpr std::array<const char*, 3> TEMPLATE_FILES{
+	"single_one_star.png",
+	"double_one_star.png",
+	"single_two_star.png"
+};
+
+constexpr std::array<Drop, 3> TEMPLATE_DROPS{
+	Drop::SingleOneStar,
+	Drop::DoubleOneStar,
+	Drop::SingleTwoStar
+};
+
+constexpr std::size_t SINGLE_ONE_STAR = 0;
+constexpr std::size_t DOUBLE_ONE_STAR = 1;
+
+}
+
+DropClassifier::DropClassifier() {
+	m_valid = true;
+	for (std::size_t i = 0; i < TEMPLATE_FILES.size(); ++i) {
+		QImageReader reader{ QString{ TEMPLATE_DIR } + TEMPLATE_FILES[i] };
+		QImage templ = reader.read();
+		if (templ.isNull()) {
+			m_valid = false;
+			return;
+		}
+		const int width = std::max(1, templ.width() * WORK_WIDTH / REFERENCE_WIDTH);
+		const int height = std::max(1, templ.height() * WORK_WIDTH / REFERENCE_WIDTH);
+		m_templates[i] = to_gray(templ.scaled(width, height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+	}
+}
+
+bool DropClassifier::valid() const {
+	return m_valid;
+}
+
+DropClassifier::GrayImage DropClassifier::to_gray(const QImage& image) {
+	const QImage gray = image.convertToFormat(QImage::Format_Grayscale8);
+	GrayImage res;
+	res.width = gray.width();
+	res.height = gray.height();
+	res.pixels.resize(static_cast<std::size_t>(res.width) * res.height);
+	for (int y = 0; y < res.height; ++y)
+		std::memcpy(res.pixels.data() + static_cast<std::size_t>(y) * res.width, gray.constScanLine(y), res.width);
+	return res;
+}
+
+std::uint32_t DropClassifier::sad_row(const std::uint8_t* a, const std::uint8_t* b, int n) {
+	std::uint32_t sum = 0;
+	int i = 0;
+#ifdef GENSHINARTIFACTSPAWNSTAT_USE_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for (; i + 16 <= n; i += 16) {
+		const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+		acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+	}
+	sum += static_cast<std::uint32_t>(_mm_cvtsi128_si32(acc));
+	sum += static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+#endif
+	for (; i < n; ++i)
+		sum += static_cast<std::uint32_t>(std::abs(a[i] - b[i]));
+	return sum;
+}
+
+std::uint64_t DropClassifier::best_match(const GrayImage& image, const GrayImage& templ, std::uint64_t bound) {
+	if (templ.width > image.width || templ.height > image.height) return bound;
+
+	for (int y = 0; y + templ.height <= image.height; ++y) {
+		for (int x = 0; x + templ.width <= image.width; ++x) {
+			std::uint64_t sad = 0;
+			for (int ty = 0; ty < templ.height && sad < bound; ++ty) {
+				const auto* image_row = image.pixels.data() + static_cast<std::size_t>(y + ty) * image.width + x;
+				const auto* templ_row = templ.pixels.data() + static_cast<std::size_t>(ty) * templ.width;
+				sad += sad_row(image_row, templ_row, templ.width);
+			}
+			bound = std::min(bound, sad);
+		}
+	}
+	return bound;
+}
+
+Drop DropClassifier::classify(const QImage& screenshot) const {
+	if (!m_valid || screenshot.isNull()) return Drop::None;
+
+	const GrayImage image = to_gray(screenshot.width() == WORK_WIDTH
+	  ? screenshot
+	  : screenshot.scaledToWidth(WORK_WIDTH, Qt::SmoothTransformation));
+
+	std::array<double, 3> scores;
+	scores.fill(MAX_MEAN_DIFF);
+	std::size_t best = 0;
+	for (std::size_t i = 0; i < m_templates.size(); ++i) {
+		const auto& templ = m_templates[i];
+		const std::uint64_t pixel_count = static_cast<std::uint64_t>(templ.width) * templ.height;
+		// scores further than MIN_MARGIN behind the best one can't change the result
+		const double limit = std::min<double>(MAX_MEAN_DIFF, scores[best] + MIN_MARGIN);
+		const auto bound = static_cast<std::uint64_t>(limit * pixel_count);
+		scores[i] = static_cast<double>(best_match(image, templ, bound)) / pixel_count;
+		if (scores[i] < scores[best]) best = i;
+	}
+	if (scores[best] >= MAX_MEAN_DIFF) return Drop::None;
+
+	// a double one-star drop shows the single one-star icon as well -> the more specific template wins the tie
+	if (best == SINGLE_ONE_STAR && scores[DOUBLE_ONE_STAR] < scores[best] + MIN_MARGIN)
+		best = DOUBLE_ONE_STAR;
+
+	for (std::size_t i = 0; i < scores.size(); ++i) {
+		if (i == best || (best == DOUBLE_ONE_STAR && i == SINGLE_ONE_STAR)) continue;
+		if (scores[i] < scores[best] + MIN_MARGIN) return Drop::None; // ambiguous
+	}
+	return TEMPLATE_DROPS[best];
+}
+
+Drop DropClassifier::classify(const QString& screenshot_file) const {
+	QImageReader reader{ screenshot_file };
+	return classify(reader.read());
+}
+
+Drop ClassifyScreenshot::operator()(const QString& screenshot_file) const {
+	return classifier->classify(screenshot_file);
+}
+
+}
\ No newline at end of file
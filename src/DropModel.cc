@@ -0,0 +1,35 @@
+#include <cstring>
+
+#include <DropModel.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+void DropModel::resize(std::size_t rows) {
+	m_drops.resize(rows, static_cast<std::uint8_t>(Drop::None));
+}
+
+std::size_t DropModel::size() const {
+	return m_drops.size();
+}
+
+Drop DropModel::drop(std::size_t row) const {
+	return static_cast<Drop>(m_drops.at(row));
+}
+
+void DropModel::set_drop(std::size_t row, Drop drop) {
+	auto& current = m_drops.at(row);
+	if (current == static_cast<std::uint8_t>(drop)) return;
+	current = static_cast<std::uint8_t>(drop);
+	emit drop_changed(row);
+}
+
+void DropModel::reset() {
+	std::memset(m_drops.data(), static_cast<int>(Drop::None), m_drops.size());
+	emit drops_reset();
+}
+
+DropModel::Snapshot DropModel::snapshot() const {
+	return std::make_shared<const std::vector<std::uint8_t>>(m_drops);
+}
+
+}
\ No newline at end of file
@@ -1,14 +1,44 @@
 #include <QtCore/QPoint>
-#include <QtGui/QKeyEvent>
+#include <QtCore/QTimer>
+#include <QtWidgets/QApplication>
 #include <QtWidgets/QScrollBar>
 
 #include <DropSelectHandler.hh>
 
 namespace GenshinArtifactSpawnStat {
 
-DropSelectHandler::DropSelectHandler(std::vector<QWidget*> focus_chain, QScrollArea* focus_chain_container) :
+DropSelectHandler::DropSelectHandler(std::vector<QWidget*> focus_chain, std::vector<std::size_t> rows, QScrollArea* focus_chain_container, DropModel& drops, InputLatency& latency) :
 		m_focus_chain{ focus_chain },
-		m_focus_chain_container{ focus_chain_container } {}
+		m_rows{ rows },
+		m_focus_chain_container{ focus_chain_container },
+		m_drops{ drops },
+		m_latency{ latency } {
+	for (std::size_t i = 0; i < m_focus_chain.size(); ++i)
+		m_chain_index[m_focus_chain[i]] = i;
+}
+
+DropSelectHandler::~DropSelectHandler() {
+	detach();
+}
+
+void DropSelectHandler::attach() {
+	if (m_attached) return;
+	m_attached = true;
+
+	// application wide, so the keys are seen before a focused radio button eats them
+	qApp->installEventFilter(this);
+	m_focus_connection = connect(qApp, &QApplication::focusChanged, this, &DropSelectHandler::focus_changed);
+	if (const auto i = focus_index(); i < m_focus_chain.size())
+		set_cursor(i);
+}
+
+void DropSelectHandler::detach() {
+	if (!m_attached) return;
+	apply_pending(); // keys typed before switching still belong to this chain
+	qApp->removeEventFilter(this);
+	disconnect(m_focus_connection);
+	m_attached = false;
+}
 
 bool DropSelectHandler::check_focus(const QWidget* w) const {
 	if (w->hasFocus()) return true;
@@ -25,49 +55,131 @@ std::size_t DropSelectHandler::focus_index() const {
 	return focus_i;
 }
 
-bool DropSelectHandler::valid_focus_index(std::size_t i) const {
-	return !m_focus_chain.empty() && i < m_focus_chain.size();
+std::size_t DropSelectHandler::chain_index(const QWidget* w) const {
+	for (; w != nullptr; w = w->parentWidget())
+		if (auto it = m_chain_index.find(w); it != m_chain_index.end())
+			return it->second;
+	return m_focus_chain.size();
 }
 
-void DropSelectHandler::focus_next() {
-	auto curr = focus_index();
-	if (!valid_focus_index(curr)) return;
-
-	if (curr == m_focus_chain.size() - 1) return;
-	set_focus(m_focus_chain[curr + 1]);
+bool DropSelectHandler::inside_container(const QObject* o) const {
+	if (!o->isWidgetType()) return false;
+	const auto* w = static_cast<const QWidget*>(o);
+	return w == m_focus_chain_container || m_focus_chain_container->isAncestorOf(w);
 }
 
-void DropSelectHandler::focus_prev() {
-	auto curr = focus_index();
-	if (!valid_focus_index(curr)) return;
+void DropSelectHandler::enqueue(const QKeyEvent* ke) {
+	m_pending.push_back({ ke->key(), m_latency.received(ke->timestamp()) });
+	if (m_drain_scheduled) return;
 
-	if (curr == 0) return;
-	set_focus(m_focus_chain[curr - 1]);
+	// one drain per event loop pass, a burst of keys costs a single scroll & repaint
+	m_drain_scheduled = true;
+	QTimer::singleShot(0, this, &DropSelectHandler::drain);
 }
 
-void DropSelectHandler::set_focus(QWidget* target) {
-	target->setFocus();
-	auto target_pos = target->mapTo(m_focus_chain_container, QPoint{ 0, 0 });
-	auto* vbar = m_focus_chain_container->verticalScrollBar();
-	vbar->setValue(vbar->value() + target_pos.y());
+void DropSelectHandler::drain() {
+	m_drain_scheduled = false;
+	if (apply_pending()) sync_focus();
 }
 
-bool DropSelectHandler::eventFilter(QObject*, QEvent* e) {
-	if (e->type() == QEvent::KeyPress) {
-		QKeyEvent* ke = static_cast<QKeyEvent*>(e);
-		switch (ke->key()) {
+bool DropSelectHandler::apply_pending() {
+	if (m_pending.empty()) return false;
+
+	while (!m_pending.empty()) {
+		const auto pending = m_pending.front();
+		m_pending.pop_front();
+		auto outcome = InputLatency::Outcome::Ignored;
+		switch (pending.key) {
 			case Qt::Key_1:
+				outcome = apply_drop(Drop::SingleOneStar);
+				break;
 			case Qt::Key_2:
+				outcome = apply_drop(Drop::DoubleOneStar);
+				break;
 			case Qt::Key_3:
-				focus_next();
+				outcome = apply_drop(Drop::SingleTwoStar);
 				break;
 			case Qt::Key_Up:
-				focus_prev();
-				return true;
+				outcome = move_cursor(-1);
+				break;
 			case Qt::Key_Down:
-				focus_next();
-				return true;
+				outcome = move_cursor(1);
+				break;
 		}
+		m_latency.handled(pending.received, outcome);
+	}
+	return true;
+}
+
+InputLatency::Outcome DropSelectHandler::apply_drop(Drop drop) {
+	if (m_cursor >= m_rows.size()) return InputLatency::Outcome::Ignored;
+
+	const auto row = m_rows[m_cursor];
+	const bool overwritten = m_at_end;
+	const bool changed = m_drops.drop(row) != drop;
+	m_drops.set_drop(row, drop);
+	if (m_cursor + 1 < m_rows.size())
+		++m_cursor;
+	else
+		m_at_end = true;
+
+	if (overwritten) return InputLatency::Outcome::Overwritten;
+	return changed ? InputLatency::Outcome::Applied : InputLatency::Outcome::Ignored;
+}
+
+InputLatency::Outcome DropSelectHandler::move_cursor(int step) {
+	if (step < 0 && m_cursor > 0)
+		set_cursor(m_cursor - 1);
+	else if (step > 0 && m_cursor + 1 < m_focus_chain.size())
+		set_cursor(m_cursor + 1);
+	else
+		return InputLatency::Outcome::Ignored; // already at the first/last spot
+
+	return InputLatency::Outcome::Moved;
+}
+
+void DropSelectHandler::set_cursor(std::size_t i) {
+	m_cursor = i;
+	m_at_end = false;
+}
+
+void DropSelectHandler::sync_focus() {
+	if (m_cursor >= m_focus_chain.size()) return;
+	auto* target = m_focus_chain[m_cursor];
+	if (!check_focus(target)) {
+		m_moving_focus = true;
+		target->setFocus();
+		m_moving_focus = false;
+	}
+	auto target_pos = target->mapTo(m_focus_chain_container, QPoint{ 0, 0 });
+	auto* vbar = m_focus_chain_container->verticalScrollBar();
+	vbar->setValue(vbar->value() + target_pos.y());
+}
+
+void DropSelectHandler::focus_changed(QWidget*, QWidget* now) {
+	if (m_moving_focus || now == nullptr) return;
+	const auto i = chain_index(now);
+	if (i >= m_focus_chain.size()) return;
+
+	// clicked on another spot: earlier keys go where they were typed, the rest follow
+	apply_pending();
+	set_cursor(i);
+}
+
+bool DropSelectHandler::eventFilter(QObject* o, QEvent* e) {
+	if (e->type() != QEvent::KeyPress || !inside_container(o)) return false;
+
+	QKeyEvent* ke = static_cast<QKeyEvent*>(e);
+	switch (ke->key()) {
+		case Qt::Key_1:
+		case Qt::Key_2:
+		case Qt::Key_3:
+			if (!ke->isAutoRepeat()) enqueue(ke);
+			return true;
+		case Qt::Key_Up:
+		case Qt::Key_Down:
+			enqueue(ke);
+			return true;
 	}
 	return false;
 }
@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include <InputLatency.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+InputLatency::Stamp InputLatency::received(unsigned long event_timestamp_ms) {
+	m_received++;
+
+	Stamp stamp;
+	stamp.dispatched = Clock::now();
+	if (event_timestamp_ms == 0) return stamp;
+
+	const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(stamp.dispatched.time_since_epoch()).count();
+	stamp.offset_ms = now_ms - static_cast<std::int64_t>(event_timestamp_ms);
+	stamp.has_timestamp = true;
+	m_min_offset_ms = std::min(m_min_offset_ms, stamp.offset_ms);
+	return stamp;
+}
+
+void InputLatency::handled(const Stamp& stamp, Outcome outcome) {
+	m_outcomes[static_cast<std::size_t>(outcome)]++;
+
+	const auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - stamp.dispatched).count();
+	m_samples.push_back({ stamp.offset_ms, stamp.has_timestamp, static_cast<std::uint32_t>(std::max<decltype(us)>(0, us)) });
+}
+
+std::string InputLatency::summary() const {
+	// the least delayed key defines "no dispatch delay"
+	std::vector<std::uint32_t> samples_us;
+	samples_us.reserve(m_samples.size());
+	for (const auto& sample : m_samples) {
+		const auto dispatch_us = sample.has_timestamp ? (sample.offset_ms - m_min_offset_ms) * 1000 : 0;
+		samples_us.push_back(static_cast<std::uint32_t>(dispatch_us + sample.queued_us));
+	}
+
+	auto percentile = [&samples_us](double p) -> std::uint32_t {
+		if (samples_us.empty()) return 0;
+		const auto n = static_cast<std::size_t>(p * (samples_us.size() - 1));
+		std::nth_element(samples_us.begin(), samples_us.begin() + n, samples_us.end());
+		return samples_us[n];
+	};
+
+	double mean_us = 0.0;
+	for (auto us : samples_us)
+		mean_us += us;
+	if (!samples_us.empty()) mean_us /= samples_us.size();
+
+	std::uint64_t handled = 0;
+	for (auto n : m_outcomes)
+		handled += n;
+
+	std::ostringstream os;
+	os << std::fixed << std::setprecision(3)
+	   << "Keys received: " << m_received << '\n'
+	   << "Drops applied: " << m_outcomes[static_cast<std::size_t>(Outcome::Applied)] << '\n'
+	   << "Overwritten at route end: " << m_outcomes[static_cast<std::size_t>(Outcome::Overwritten)] << '\n'
+	   << "Ignored: " << m_outcomes[static_cast<std::size_t>(Outcome::Ignored)] << '\n'
+	   << "Cursor moves: " << m_outcomes[static_cast<std::size_t>(Outcome::Moved)] << '\n'
+	   << "Not handled: " << m_received - handled << '\n'
+	   << "Mean: " << mean_us / 1000.0 << " ms\n"
+	   << "p50: " << percentile(0.50) / 1000.0 << " ms\n"
+	   << "p99: " << percentile(0.99) / 1000.0 << " ms\n"
+	   << "Max: " << percentile(1.0) / 1000.0 << " ms";
+	return os.str();
+}
+
+}
\ No newline at end of file
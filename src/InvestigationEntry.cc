@@ -14,7 +14,9 @@
 
 namespace GenshinArtifactSpawnStat {
 
-InvestigationEntry::InvestigationEntry(const QString& map_path, const QString& screenshot_path) {
+InvestigationEntry::InvestigationEntry(const QString& map_path, const QString& screenshot_path, DropModel& drops, std::size_t row) :
+		m_drops{ drops },
+		m_row{ row } {
 	setFrameShape(QFrame::Panel);
 
 	load_images(map_path, screenshot_path);
@@ -73,6 +75,9 @@ void InvestigationEntry::init_drop_choice_box() {
 	m_1_one_star_button = new QRadioButton{ "★" };
 	m_2_one_star_button = new QRadioButton{ "★ x2" };
 	m_1_two_star_button = new QRadioButton{ "★★" };
+	connect(m_1_one_star_button, &QRadioButton::clicked, this, [this]() { set_drop(Drop::SingleOneStar); });
+	connect(m_2_one_star_button, &QRadioButton::clicked, this, [this]() { set_drop(Drop::DoubleOneStar); });
+	connect(m_1_two_star_button, &QRadioButton::clicked, this, [this]() { set_drop(Drop::SingleTwoStar); });
 
 	auto* drop_choice_layout = new QGridLayout;
 	drop_choice_layout->addWidget(m_1_one_star_stats_label, 0, 0);
@@ -92,25 +97,23 @@ void InvestigationEntry::init_drop_choice_box() {
 
 void InvestigationEntry::keyPressEvent(QKeyEvent* e) {
 	if (!e->isAutoRepeat()) {
-		if (e->key() == Qt::Key_1) m_1_one_star_button->toggle();
-		if (e->key() == Qt::Key_2) m_2_one_star_button->toggle();
-		if (e->key() == Qt::Key_3) m_1_two_star_button->toggle();
+		if (e->key() == Qt::Key_1 && m_1_one_star_button->isEnabled()) set_drop(Drop::SingleOneStar);
+		if (e->key() == Qt::Key_2 && m_2_one_star_button->isEnabled()) set_drop(Drop::DoubleOneStar);
+		if (e->key() == Qt::Key_3 && m_1_two_star_button->isEnabled()) set_drop(Drop::SingleTwoStar);
 	}
 	QWidget::keyPressEvent(e);
 }
 
 InvestigationEntry::Drop InvestigationEntry::drop() const {
-	if (m_1_one_star_button->isChecked()) return Drop::SingleOneStar;
-	if (m_2_one_star_button->isChecked()) return Drop::DoubleOneStar;
-	if (m_1_two_star_button->isChecked()) return Drop::SingleTwoStar;
-	return Drop::None;
+	return m_drops.drop(m_row);
 }
 
 void InvestigationEntry::set_drop(Drop drop) {
-	m_1_one_star_button->setAutoExclusive(false);
-	m_2_one_star_button->setAutoExclusive(false);
-	m_1_two_star_button->setAutoExclusive(false);
-	switch (drop) {
+	m_drops.set_drop(m_row, drop);
+}
+
+void InvestigationEntry::sync_drop() {
+	switch (m_drops.drop(m_row)) {
 		case Drop::SingleOneStar:
 			m_1_one_star_button->setChecked(true);
 			break;
@@ -120,15 +123,18 @@ void InvestigationEntry::set_drop(Drop drop) {
 		case Drop::SingleTwoStar:
 			m_1_two_star_button->setChecked(true);
 			break;
-		case Drop::None:
+		case Drop::None: // exclusive buttons cannot all be unchecked
+			m_1_one_star_button->setAutoExclusive(false);
+			m_2_one_star_button->setAutoExclusive(false);
+			m_1_two_star_button->setAutoExclusive(false);
 			m_1_one_star_button->setChecked(false);
 			m_2_one_star_button->setChecked(false);
 			m_1_two_star_button->setChecked(false);
+			m_1_one_star_button->setAutoExclusive(true);
+			m_2_one_star_button->setAutoExclusive(true);
+			m_1_two_star_button->setAutoExclusive(true);
 			break;
 	}
-	m_1_one_star_button->setAutoExclusive(true);
-	m_2_one_star_button->setAutoExclusive(true);
-	m_1_two_star_button->setAutoExclusive(true);
 }
 
 void InvestigationEntry::zoom(double factor) {
@@ -0,0 +1,145 @@
+#include <algorithm>
+
+#include <RouteLayout.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+RouteLayout::RouteLayout(int column_spacing) :
+		m_column_spacing{ column_spacing } {}
+
+RouteLayout::~RouteLayout() {
+	for (auto* item : m_items)
+		delete item;
+}
+
+std::size_t RouteLayout::row_count() const {
+	return m_items.size() / 2;
+}
+
+QLayoutItem* RouteLayout::button_item(std::size_t row) const {
+	return m_items[2 * row];
+}
+
+QLayoutItem* RouteLayout::entry_item(std::size_t row) const {
+	return m_items[2 * row + 1];
+}
+
+int RouteLayout::row_height(std::size_t row) const {
+	return std::max(button_item(row)->sizeHint().height(), entry_item(row)->sizeHint().height());
+}
+
+void RouteLayout::add_row(QWidget* button, QWidget* entry) {
+	addWidget(button);
+	addWidget(entry);
+}
+
+void RouteLayout::set_order(const std::vector<std::size_t>& order) {
+	std::vector<bool> was_shown(row_count(), false);
+	for (auto row : m_order)
+		was_shown[row] = true;
+
+	std::vector<bool> shown(row_count(), false);
+	m_order.clear();
+	for (auto row : order) {
+		if (row >= row_count() || shown[row]) continue;
+		shown[row] = true;
+		m_order.push_back(row);
+	}
+
+	// only touch rows whose visibility actually changes
+	for (std::size_t row = 0; row < row_count(); ++row) {
+		if (shown[row] == was_shown[row]) continue;
+		for (auto* item : { button_item(row), entry_item(row) })
+			if (auto* w = item->widget()) w->setVisible(shown[row]);
+	}
+	invalidate();
+}
+
+const std::vector<std::size_t>& RouteLayout::order() const {
+	return m_order;
+}
+
+void RouteLayout::addItem(QLayoutItem* item) {
+	m_items.push_back(item);
+	if (m_items.size() % 2 == 0) m_order.push_back(row_count() - 1);
+	invalidate();
+}
+
+int RouteLayout::count() const {
+	return static_cast<int>(m_items.size());
+}
+
+QLayoutItem* RouteLayout::itemAt(int index) const {
+	if (index < 0 || index >= count()) return nullptr;
+	return m_items[index];
+}
+
+QLayoutItem* RouteLayout::takeAt(int index) {
+	if (index < 0 || index >= count()) return nullptr;
+	auto* item = m_items[index];
+	m_items.erase(m_items.begin() + index);
+	m_order.erase(
+	  std::remove_if(m_order.begin(), m_order.end(), [this](std::size_t row) { return row >= row_count(); }),
+	  m_order.end());
+	invalidate();
+	return item;
+}
+
+Qt::Orientations RouteLayout::expandingDirections() const {
+	return {};
+}
+
+QSize RouteLayout::sizeHint() const {
+	if (m_size_hint.isValid()) return m_size_hint;
+
+	const int spacing = std::max(0, this->spacing());
+	int button_width = 0;
+	int entry_width = 0;
+	int height = 0;
+	for (std::size_t i = 0; i < m_order.size(); ++i) {
+		const auto row = m_order[i];
+		button_width = std::max(button_width, button_item(row)->sizeHint().width());
+		entry_width = std::max(entry_width, entry_item(row)->sizeHint().width());
+		height += row_height(row) + (i > 0 ? spacing : 0);
+	}
+
+	const auto margins = contentsMargins();
+	m_size_hint = QSize{
+		button_width + m_column_spacing + entry_width + margins.left() + margins.right(),
+		height + margins.top() + margins.bottom()
+	};
+	return m_size_hint;
+}
+
+QSize RouteLayout::minimumSize() const {
+	return sizeHint();
+}
+
+void RouteLayout::setGeometry(const QRect& rect) {
+	QLayout::setGeometry(rect);
+
+	const QRect area = rect.marginsRemoved(contentsMargins());
+	const int spacing = std::max(0, this->spacing());
+	int button_width = 0;
+	for (auto row : m_order)
+		button_width = std::max(button_width, button_item(row)->sizeHint().width());
+
+	int y = area.top();
+	for (auto row : m_order) {
+		const int height = row_height(row);
+		button_item(row)->setGeometry(QRect{ area.left(), y, button_width, height });
+		entry_item(row)->setGeometry(QRect{
+		  area.left() + button_width + m_column_spacing,
+		  y,
+		  area.width() - button_width - m_column_spacing,
+		  height });
+		y += height + spacing;
+	}
+}
+
+void RouteLayout::invalidate() {
+	m_size_hint = QSize{};
+	QLayout::invalidate();
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <SpotStatsIndex.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+const char* SpotStatsIndex::metric_name(Metric metric) {
+	switch (metric) {
+		case Metric::Records:
+			return "Records";
+		case Metric::AvgExp:
+			return "Avg. exp";
+		case Metric::SingleOneStarRate:
+			return "★ %";
+		case Metric::DoubleOneStarRate:
+			return "★ x2 %";
+		case Metric::SingleTwoStarRate:
+			return "★★ %";
+	}
+	return "";
+}
+
+bool SpotStatsIndex::View::active() const {
+	return filter_metric.has_value() || sort_metric.has_value();
+}
+
+void SpotStatsIndex::resize(std::size_t rows) {
+	while (m_values.size() > rows) {
+		const auto row = m_values.size() - 1;
+		for (std::size_t m = 0; m < METRIC_COUNT; ++m)
+			m_indexes[m].erase({ m_values[row][m], row });
+		m_values.pop_back();
+	}
+	while (m_values.size() < rows) {
+		const auto row = m_values.size();
+		m_values.push_back({});
+		for (std::size_t m = 0; m < METRIC_COUNT; ++m)
+			m_indexes[m].insert({ 0.0, row });
+	}
+}
+
+void SpotStatsIndex::update(std::size_t row, int single_one_star_drops, int double_one_star_drops, int single_two_star_drops) {
+	if (row >= m_values.size()) resize(row + 1);
+
+	// same numbers as InvestigationEntry::set_stats shows
+	const auto records = single_one_star_drops + double_one_star_drops + single_two_star_drops;
+	const double divisor = records > 0 ? records : 1.0;
+	const std::array<double, METRIC_COUNT> values{
+		static_cast<double>(records),
+		420.0 * (1.0 * single_one_star_drops + 2.0 * double_one_star_drops + 2.0 * single_two_star_drops) / divisor,
+		100.0 * single_one_star_drops / divisor,
+		100.0 * double_one_star_drops / divisor,
+		100.0 * single_two_star_drops / divisor
+	};
+
+	for (std::size_t m = 0; m < METRIC_COUNT; ++m) {
+		if (m_values[row][m] == values[m]) continue;
+		m_indexes[m].erase({ m_values[row][m], row });
+		m_indexes[m].insert({ values[m], row });
+	}
+	m_values[row] = values;
+}
+
+double SpotStatsIndex::value(std::size_t row, Metric metric) const {
+	return m_values.at(row)[static_cast<std::size_t>(metric)];
+}
+
+std::vector<std::size_t> SpotStatsIndex::apply(const View& view, const std::vector<std::size_t>& rows) const {
+	std::vector<char> selected(m_values.size(), 0);
+	for (auto row : rows)
+		if (row < selected.size()) selected[row] = 1;
+
+	if (view.filter_metric) {
+		const auto& index = m_indexes[static_cast<std::size_t>(*view.filter_metric)];
+		std::vector<char> passed(m_values.size(), 0);
+		for (auto it = index.lower_bound({ view.min_value, 0 }); it != index.end(); ++it)
+			passed[it->second] = 1;
+		for (std::size_t row = 0; row < selected.size(); ++row)
+			selected[row] = selected[row] && passed[row];
+	}
+
+	std::vector<std::size_t> res;
+	auto take = [&selected, &res](std::size_t row) {
+		if (!selected[row]) return;
+		selected[row] = 0; // each row only once
+		res.push_back(row);
+	};
+
+	if (view.sort_metric) {
+		const auto& index = m_indexes[static_cast<std::size_t>(*view.sort_metric)];
+		if (view.descending)
+			for (auto it = index.rbegin(); it != index.rend(); ++it)
+				take(it->second);
+		else
+			for (const auto& key : index)
+				take(key.second);
+	} else {
+		for (auto row : rows)
+			if (row < selected.size()) take(row);
+	}
+	return res;
+}
+
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
+#include <QtCore/QCommandLineParser>
 #include <QtWidgets/QApplication>
 
 #include <AppWindow.hh>
@@ -17,13 +18,22 @@ void init_app(QApplication& app) {
 	load_stylesheet(app);
 }
 
+std::string parse_route(QApplication& app) {
+	QCommandLineParser parser;
+	parser.addHelpOption();
+	QCommandLineOption route_option{ { "r", "route" }, "Start with the route profile <name>.", "name" };
+	parser.addOption(route_option);
+	parser.process(app);
+	return parser.value(route_option).toStdString();
+}
+
 int main(int argc, char** argv) {
 	using namespace GenshinArtifactSpawnStat;
 
 	QApplication app{ argc, argv };
 	init_app(app);
 
-	AppWindow window;
+	AppWindow window{ parse_route(app) };
 
 	return app.exec();
 }
@@ -0,0 +1,23 @@
+#include <sys/resource.h>
+
+#ifndef TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_FDLIMIT_HH_
+#define TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_FDLIMIT_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Raises the soft limit of open files to the hard limit, the default of 1024 is
+// too low for thousands of connections. Returns the limit now in effect.
+inline rlim_t raise_fd_limit() {
+	rlimit limit{};
+	if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return 0;
+	if (limit.rlim_cur < limit.rlim_max) {
+		const auto soft = limit.rlim_cur;
+		limit.rlim_cur = limit.rlim_max;
+		if (setrlimit(RLIMIT_NOFILE, &limit) != 0) return soft;
+	}
+	return limit.rlim_cur;
+}
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+
+#include <LatencyRecorder.hh>
+
+#ifndef TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_HTTPSERVER_HH_
+#define TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_HTTPSERVER_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Minimal HTTP/1.1 server with keep-alive: every worker thread polls its own
+// SO_REUSEPORT listening socket, so the kernel spreads new connections evenly,
+// and its own set of connections. Listens on IPv6 & IPv4 where possible.
+class HttpServer {
+public:
+	struct Request {
+		std::string method;
+		std::string path;
+		std::string accept;
+		std::string accept_encoding;
+		std::string body;
+	};
+	struct Response {
+		int status = 200;
+		std::string content_type = "application/json";
+		std::string content_encoding;
+		std::string body;
+	};
+	using Handler = std::function<Response(const Request&)>;
+
+private:
+	inline static constexpr std::size_t MAX_REQUEST_SIZE = 16 * 1024 * 1024;
+	// without SO_REUSEPORT the workers share one socket, then no worker may grab a whole burst
+	inline static constexpr int MAX_SHARED_ACCEPTS = 4;
+	// out of file descriptors: the listener stays readable, so stop polling it for this long
+	inline static constexpr int ACCEPT_PAUSE_MS = 100;
+
+	unsigned short m_port;
+	std::vector<int> m_listen_fds;
+	Handler m_handler;
+	LatencyRecorder& m_recorder;
+
+	struct Connection;
+	int open_listener() const;
+	void worker(int listen_fd, bool shared_listener, const std::atomic<bool>& stop);
+	bool read_requests(Connection&);
+
+public:
+	HttpServer(unsigned short port, Handler handler, LatencyRecorder& recorder);
+	HttpServer(const HttpServer&) = delete;
+	HttpServer& operator=(const HttpServer&) = delete;
+	~HttpServer();
+
+	// blocks until stop is set
+	void run(unsigned threads, const std::atomic<bool>& stop);
+};
+
+}
+
+#endif
\ No newline at end of file
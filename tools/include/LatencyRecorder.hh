@@ -0,0 +1,41 @@
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+#ifndef TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_LATENCYRECORDER_HH_
+#define TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_LATENCYRECORDER_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Collects request latencies from several threads and reports
+// throughput and tail latency per interval and over the whole run.
+class LatencyRecorder {
+
+	using Clock = std::chrono::steady_clock;
+
+	std::mutex m_mutex;
+	std::vector<std::uint32_t> m_interval_us;
+	std::vector<std::uint32_t> m_total_us;
+	std::uint64_t m_interval_errors = 0;
+	std::uint64_t m_total_errors = 0;
+	std::uint64_t m_interval_timeouts = 0;
+	std::uint64_t m_total_timeouts = 0;
+	Clock::time_point m_start = Clock::now();
+	Clock::time_point m_interval_start = m_start;
+
+	static void print(std::ostream&, const char* label, std::vector<std::uint32_t>& samples_us, std::uint64_t errors, std::uint64_t timeouts, double seconds);
+
+public:
+	void record(Clock::duration latency);
+	void record_error();
+	// request without a response in time, it never shows up as a latency sample
+	void record_timeout();
+	void report_interval(std::ostream&);
+	void report_total(std::ostream&);
+};
+
+}
+
+#endif
\ No newline at end of file
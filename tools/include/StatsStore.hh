@@ -0,0 +1,55 @@
+#include <vector>
+#include <array>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+
+#ifndef TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_STATSSTORE_HH_
+#define TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_STATSSTORE_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Aggregated drop counts per spot as served to the client, either as
+// {"error": false, "drops": [[single_one_star, double_one_star, single_two_star], ...]}
+// or as packed little-endian int32 triples in the same order.
+class StatsStore {
+public:
+	inline static constexpr auto JSON_TYPE = "application/json";
+	inline static constexpr auto BINARY_TYPE = "application/vnd.genshinartifactspawnstat.stats";
+
+	enum class Encoding {
+		Json,
+		Binary
+	};
+
+private:
+	inline static constexpr std::size_t MAX_SPOTS = 100000;
+
+	mutable std::shared_mutex m_mutex;
+	std::vector<std::array<std::int32_t, 3>> m_drops;
+	std::uint64_t m_version = 0;
+
+	struct CacheEntry {
+		std::shared_ptr<const std::string> body;
+		std::uint64_t version = 0;
+	};
+	// only guards swapping cache entries, bodies are built outside of it
+	mutable std::mutex m_cache_mutex;
+	mutable std::array<CacheEntry, 4> m_cache; // [encoding][gzip]
+
+	std::string encode(Encoding) const;
+
+public:
+	static bool gzip_supported();
+
+	// parses {"drops": [[row, drop], ...]}; returns false and changes nothing on invalid input
+	bool submit(const std::string& body);
+	// nullptr if compressing failed
+	std::shared_ptr<const std::string> stats(Encoding, bool gzip) const;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include <QtCore/QString>
+#include <QtCore/QSize>
+
+#ifndef TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_SYNTHETICRESOURCES_HH_
+#define TOOLS_INCLUDE_GENSHINARTIFACTSPAWNSTAT_SYNTHETICRESOURCES_HH_
+
+namespace GenshinArtifactSpawnStat {
+
+// Writes a resource/ tree as read by AppWindow::create_entries:
+// resource/001.png (map), resource/001a.png, resource/001b.png, ... (spots)
+class SyntheticResources {
+public:
+	inline static constexpr int MAX_SPOTS = 26; // spot suffixes a-z
+
+	struct Options {
+		int maps = 10;
+		int spots = 5;
+		// defaults roughly match map crops and 1080p screenshots in size on disk
+		QSize map_size{ 800, 800 };
+		QSize spot_size{ 1280, 720 };
+		unsigned seed = 1;
+	};
+
+	// dir is the directory that will contain resource/
+	static bool generate(const QString& dir, const Options&);
+};
+
+}
+
+#endif
\ No newline at end of file
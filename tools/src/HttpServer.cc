@@ -0,0 +1,297 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <chrono>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <HttpServer.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void set_nonblocking(int fd) {
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+std::string lowercase(std::string s) {
+	std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+	return s;
+}
+
+const char* reason(int status) {
+	switch (status) {
+		case 200: return "OK";
+		case 400: return "Bad Request";
+		case 404: return "Not Found";
+		case 405: return "Method Not Allowed";
+		default: return "Internal Server Error";
+	}
+}
+
+}
+
+struct HttpServer::Connection {
+	int fd = -1;
+	std::string in;
+	std::string out;
+	std::size_t out_offset = 0;
+	bool close_after_write = false;
+	bool closed = false;
+	Clock::time_point request_start;
+	std::deque<Clock::time_point> pending_starts;
+};
+
+HttpServer::HttpServer(unsigned short port, Handler handler, LatencyRecorder& recorder) :
+		m_port{ port },
+		m_handler{ std::move(handler) },
+		m_recorder{ recorder } {
+	m_listen_fds.push_back(open_listener()); // fail early if the port is taken
+}
+
+HttpServer::~HttpServer() {
+	for (int fd : m_listen_fds)
+		close(fd);
+}
+
+int HttpServer::open_listener() const {
+	// dual stack, "localhost" may resolve to ::1 first; IPv4 only where IPv6 is missing
+	bool ipv6 = true;
+	int fd = socket(AF_INET6, SOCK_STREAM, 0);
+	if (fd < 0) {
+		ipv6 = false;
+		fd = socket(AF_INET, SOCK_STREAM, 0);
+	}
+	if (fd < 0) throw std::runtime_error{ std::string{ "socket: " } + std::strerror(errno) };
+
+	int one = 1;
+	int zero = 0;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+#ifdef SO_REUSEPORT
+	setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+#endif
+
+	sockaddr_storage addr{};
+	socklen_t addr_len = 0;
+	if (ipv6) {
+		setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero));
+		auto* addr6 = reinterpret_cast<sockaddr_in6*>(&addr);
+		addr6->sin6_family = AF_INET6;
+		addr6->sin6_addr = in6addr_any;
+		addr6->sin6_port = htons(m_port);
+		addr_len = sizeof(sockaddr_in6);
+	} else {
+		auto* addr4 = reinterpret_cast<sockaddr_in*>(&addr);
+		addr4->sin_family = AF_INET;
+		addr4->sin_addr.s_addr = htonl(INADDR_ANY);
+		addr4->sin_port = htons(m_port);
+		addr_len = sizeof(sockaddr_in);
+	}
+	if (bind(fd, reinterpret_cast<sockaddr*>(&addr), addr_len) < 0 || listen(fd, SOMAXCONN) < 0) {
+		const std::string error = std::strerror(errno);
+		close(fd);
+		throw std::runtime_error{ "bind/listen on port " + std::to_string(m_port) + ": " + error };
+	}
+	set_nonblocking(fd);
+	return fd;
+}
+
+void HttpServer::run(unsigned threads, const std::atomic<bool>& stop) {
+	threads = std::max(1u, threads);
+#ifdef SO_REUSEPORT
+	const bool shared_listener = false;
+	while (m_listen_fds.size() < threads)
+		m_listen_fds.push_back(open_listener());
+#else
+	const bool shared_listener = threads > 1;
+#endif
+
+	std::vector<std::thread> workers;
+	for (unsigned t = 1; t < threads; ++t) {
+		const int listen_fd = m_listen_fds[shared_listener ? 0 : t];
+		workers.emplace_back([this, listen_fd, shared_listener, &stop]() { worker(listen_fd, shared_listener, stop); });
+	}
+	worker(m_listen_fds[0], shared_listener, stop);
+	for (auto& w : workers)
+		w.join();
+}
+
+bool HttpServer::read_requests(Connection& c) {
+	while (!c.in.empty()) {
+		const auto header_end = c.in.find("\r\n\r\n");
+		if (header_end == std::string::npos) return c.in.size() <= MAX_REQUEST_SIZE;
+
+		Request req;
+		std::size_t content_length = 0;
+		bool keep_alive = true;
+
+		// request line
+		const auto line_end = c.in.find("\r\n");
+		const auto method_end = c.in.find(' ');
+		const auto path_end = method_end == std::string::npos ? std::string::npos : c.in.find(' ', method_end + 1);
+		if (method_end == std::string::npos || path_end == std::string::npos || path_end > line_end) return false;
+		req.method = c.in.substr(0, method_end);
+		req.path = c.in.substr(method_end + 1, path_end - method_end - 1);
+		if (c.in.compare(path_end + 1, line_end - path_end - 1, "HTTP/1.0") == 0) keep_alive = false;
+
+		// headers
+		for (auto pos = line_end + 2; pos < header_end;) {
+			const auto next = c.in.find("\r\n", pos);
+			const auto colon = c.in.find(':', pos);
+			if (colon != std::string::npos && colon < next) {
+				const auto name = lowercase(c.in.substr(pos, colon - pos));
+				auto value_begin = c.in.find_first_not_of(' ', colon + 1);
+				auto value = value_begin < next ? c.in.substr(value_begin, next - value_begin) : std::string{};
+				if (name == "content-length") {
+					try {
+						content_length = std::stoul(value);
+					} catch (const std::exception&) {
+						return false;
+					}
+				} else if (name == "connection") {
+					value = lowercase(value);
+					if (value == "close") keep_alive = false;
+					if (value == "keep-alive") keep_alive = true;
+				} else if (name == "accept") {
+					req.accept = value;
+				} else if (name == "accept-encoding") {
+					req.accept_encoding = lowercase(value);
+				}
+			}
+			pos = next + 2;
+		}
+
+		if (content_length > MAX_REQUEST_SIZE) return false;
+		const auto request_size = header_end + 4 + content_length;
+		if (c.in.size() < request_size) return true;
+		req.body = c.in.substr(header_end + 4, content_length);
+		c.in.erase(0, request_size);
+
+		const Response res = m_handler(req);
+		c.out += "HTTP/1.1 " + std::to_string(res.status) + " " + reason(res.status) + "\r\n";
+		c.out += "Content-Type: " + res.content_type + "\r\n";
+		if (!res.content_encoding.empty()) c.out += "Content-Encoding: " + res.content_encoding + "\r\n";
+		c.out += "Content-Length: " + std::to_string(res.body.size()) + "\r\n";
+		if (!keep_alive) c.out += "Connection: close\r\n";
+		c.out += "\r\n";
+		c.out += res.body;
+
+		c.pending_starts.push_back(c.request_start);
+		c.request_start = Clock::now();
+		if (!keep_alive) {
+			c.close_after_write = true;
+			c.in.clear();
+		}
+	}
+	return true;
+}
+
+void HttpServer::worker(int listen_fd, bool shared_listener, const std::atomic<bool>& stop) {
+	std::vector<Connection> conns;
+	std::vector<pollfd> pfds;
+	char buffer[64 * 1024];
+	Clock::time_point accept_paused_until;
+	bool out_of_fds = false;
+
+	auto flush = [this](Connection& c) {
+		while (c.out_offset < c.out.size()) {
+			const auto n = send(c.fd, c.out.data() + c.out_offset, c.out.size() - c.out_offset, 0);
+			if (n < 0) {
+				if (errno != EAGAIN && errno != EWOULDBLOCK) c.closed = true;
+				return;
+			}
+			c.out_offset += n;
+		}
+		c.out.clear();
+		c.out_offset = 0;
+		const auto now = Clock::now();
+		for (auto start : c.pending_starts)
+			m_recorder.record(now - start);
+		c.pending_starts.clear();
+		if (c.close_after_write) c.closed = true;
+	};
+
+	while (!stop) {
+		pfds.clear();
+		// poll ignores negative descriptors
+		pfds.push_back({ Clock::now() < accept_paused_until ? -1 : listen_fd, POLLIN, 0 });
+		for (const auto& c : conns)
+			pfds.push_back({ c.fd, static_cast<short>(c.out.empty() ? POLLIN : POLLIN | POLLOUT), 0 });
+
+		if (poll(pfds.data(), pfds.size(), 100) <= 0) continue;
+
+		for (std::size_t i = 0; i < conns.size(); ++i) {
+			auto& c = conns[i];
+			const auto revents = pfds[i + 1].revents;
+			if (revents & (POLLIN | POLLHUP | POLLERR)) {
+				for (;;) {
+					const auto n = recv(c.fd, buffer, sizeof(buffer), 0);
+					if (n > 0) {
+						if (c.in.empty()) c.request_start = Clock::now();
+						c.in.append(buffer, n);
+						continue;
+					}
+					if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) c.closed = true;
+					break;
+				}
+				if (!read_requests(c)) {
+					m_recorder.record_error();
+					c.closed = true;
+				}
+			}
+			if (!c.closed && !c.out.empty()) flush(c);
+		}
+
+		// drop closed connections
+		for (std::size_t i = 0; i < conns.size();) {
+			if (conns[i].closed) {
+				close(conns[i].fd);
+				conns[i] = std::move(conns.back());
+				conns.pop_back();
+			} else {
+				++i;
+			}
+		}
+
+		if (pfds[0].revents & POLLIN) {
+			for (int accepted = 0; !shared_listener || accepted < MAX_SHARED_ACCEPTS; ++accepted) {
+				const int fd = accept(listen_fd, nullptr, nullptr);
+				if (fd < 0) {
+					if (errno == EMFILE || errno == ENFILE) {
+						// pending connections wait in the backlog until some are closed
+						if (!out_of_fds) std::cerr << "accept: " << std::strerror(errno) << ", pausing new connections" << std::endl;
+						out_of_fds = true;
+						accept_paused_until = Clock::now() + std::chrono::milliseconds{ ACCEPT_PAUSE_MS };
+					}
+					break;
+				}
+				out_of_fds = false;
+				set_nonblocking(fd);
+				int one = 1;
+				setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+				Connection c;
+				c.fd = fd;
+				conns.push_back(std::move(c));
+			}
+		}
+	}
+
+	for (auto& c : conns)
+		close(c.fd);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <iomanip>
+
+#include <LatencyRecorder.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+void LatencyRecorder::record(Clock::duration latency) {
+	const auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+	std::lock_guard lock{ m_mutex };
+	m_interval_us.push_back(static_cast<std::uint32_t>(std::max<decltype(us)>(0, us)));
+}
+
+void LatencyRecorder::record_error() {
+	std::lock_guard lock{ m_mutex };
+	m_interval_errors++;
+}
+
+void LatencyRecorder::record_timeout() {
+	std::lock_guard lock{ m_mutex };
+	m_interval_timeouts++;
+}
+
+void LatencyRecorder::print(std::ostream& os, const char* label, std::vector<std::uint32_t>& samples_us, std::uint64_t errors, std::uint64_t timeouts, double seconds) {
+	auto percentile = [&samples_us](double p) -> std::uint32_t {
+		if (samples_us.empty()) return 0;
+		const auto n = static_cast<std::size_t>(p * (samples_us.size() - 1));
+		std::nth_element(samples_us.begin(), samples_us.begin() + n, samples_us.end());
+		return samples_us[n];
+	};
+
+	const double rps = seconds > 0.0 ? samples_us.size() / seconds : 0.0;
+	os << std::fixed << std::setprecision(3)
+	   << label
+	   << " requests: " << samples_us.size()
+	   << "  errors: " << errors
+	   << "  timeouts: " << timeouts
+	   << "  req/s: " << rps
+	   << "  p50: " << percentile(0.50) / 1000.0 << " ms"
+	   << "  p99: " << percentile(0.99) / 1000.0 << " ms"
+	   << "  p99.9: " << percentile(0.999) / 1000.0 << " ms"
+	   << "  max: " << percentile(1.0) / 1000.0 << " ms"
+	   << std::endl;
+}
+
+void LatencyRecorder::report_interval(std::ostream& os) {
+	std::vector<std::uint32_t> samples_us;
+	std::uint64_t errors = 0;
+	std::uint64_t timeouts = 0;
+	const auto now = Clock::now();
+	const auto start = m_interval_start;
+	{
+		std::lock_guard lock{ m_mutex };
+		samples_us.swap(m_interval_us);
+		errors = m_interval_errors;
+		m_interval_errors = 0;
+		m_total_errors += errors;
+		timeouts = m_interval_timeouts;
+		m_interval_timeouts = 0;
+		m_total_timeouts += timeouts;
+		m_total_us.insert(m_total_us.end(), samples_us.begin(), samples_us.end());
+		m_interval_start = now;
+	}
+	print(os, "[interval]", samples_us, errors, timeouts, std::chrono::duration<double>(now - start).count());
+}
+
+void LatencyRecorder::report_total(std::ostream& os) {
+	report_interval(os);
+	std::vector<std::uint32_t> samples_us;
+	std::uint64_t errors = 0;
+	std::uint64_t timeouts = 0;
+	{
+		std::lock_guard lock{ m_mutex };
+		samples_us = m_total_us;
+		errors = m_total_errors;
+		timeouts = m_total_timeouts;
+	}
+	print(os, "[total]   ", samples_us, errors, timeouts, std::chrono::duration<double>(Clock::now() - m_start).count());
+}
+
+}
\ No newline at end of file
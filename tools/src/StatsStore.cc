@@ -0,0 +1,139 @@
+#include <utility>
+#include <optional>
+
+#ifdef GENSHINARTIFACTSPAWNSTAT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <StatsStore.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+namespace {
+
+#ifdef GENSHINARTIFACTSPAWNSTAT_HAVE_ZLIB
+std::optional<std::string> gzip(const std::string& data) {
+	z_stream z{};
+	if (deflateInit2(&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) // +16: gzip header
+		return std::nullopt;
+
+	std::string res(deflateBound(&z, data.size()), '\0');
+	z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+	z.avail_in = data.size();
+	z.next_out = reinterpret_cast<Bytef*>(res.data());
+	z.avail_out = res.size();
+	const int status = deflate(&z, Z_FINISH); // deflateBound output always fits in one call
+	res.resize(z.total_out);
+	deflateEnd(&z);
+	if (status != Z_STREAM_END) return std::nullopt;
+	return res;
+}
+#endif
+
+}
+
+bool StatsStore::gzip_supported() {
+#ifdef GENSHINARTIFACTSPAWNSTAT_HAVE_ZLIB
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool StatsStore::submit(const std::string& body) {
+	rapidjson::Document json;
+	json.Parse(body.c_str(), body.size());
+	if (!json.IsObject() || !json.HasMember("drops") || !json["drops"].IsArray()) return false;
+
+	// check input first
+	std::vector<std::pair<std::size_t, std::size_t>> drops;
+	for (const auto& drop_arr : json["drops"].GetArray()) {
+		if (!drop_arr.IsArray() || drop_arr.Size() != 2) return false;
+		const auto& row_val = drop_arr[0];
+		const auto& drop_val = drop_arr[1];
+		if (!row_val.IsInt() || row_val.GetInt() < 0 || static_cast<std::size_t>(row_val.GetInt()) >= MAX_SPOTS) return false;
+		if (!drop_val.IsInt() || drop_val.GetInt() < 0 || drop_val.GetInt() > 2) return false;
+		drops.emplace_back(row_val.GetInt(), drop_val.GetInt());
+	}
+
+	std::unique_lock lock{ m_mutex };
+	for (const auto& [row, drop] : drops) {
+		if (row >= m_drops.size()) m_drops.resize(row + 1, { 0, 0, 0 });
+		m_drops[row][drop]++;
+	}
+	m_version++;
+	return true;
+}
+
+std::string StatsStore::encode(Encoding encoding) const {
+	if (encoding == Encoding::Binary) {
+		std::string res;
+		res.reserve(m_drops.size() * 3 * 4);
+		for (const auto& counts : m_drops) {
+			for (auto n : counts) {
+				const auto u = static_cast<std::uint32_t>(n);
+				res += static_cast<char>(u & 0xff);
+				res += static_cast<char>((u >> 8) & 0xff);
+				res += static_cast<char>((u >> 16) & 0xff);
+				res += static_cast<char>((u >> 24) & 0xff);
+			}
+		}
+		return res;
+	}
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer{ buffer };
+	writer.StartObject();
+	writer.Key("error");
+	writer.Bool(false);
+	writer.Key("drops");
+	writer.StartArray();
+	for (const auto& counts : m_drops) {
+		writer.StartArray();
+		for (auto n : counts)
+			writer.Int(n);
+		writer.EndArray();
+	}
+	writer.EndArray();
+	writer.EndObject();
+	return { buffer.GetString(), buffer.GetSize() };
+}
+
+std::shared_ptr<const std::string> StatsStore::stats(Encoding encoding, bool gzip_body) const {
+	gzip_body = gzip_body && gzip_supported();
+	auto& entry = m_cache[static_cast<std::size_t>(encoding) * 2 + (gzip_body ? 1 : 0)];
+
+	std::uint64_t version = 0;
+	std::string body;
+	{
+		std::shared_lock lock{ m_mutex };
+		version = m_version;
+		{
+			std::lock_guard cache_lock{ m_cache_mutex };
+			if (entry.body && entry.version == version) return entry.body;
+		}
+		body = encode(encoding); // readers encode side by side, only submit() waits
+	}
+
+#ifdef GENSHINARTIFACTSPAWNSTAT_HAVE_ZLIB
+	if (gzip_body) {
+		auto compressed = gzip(body);
+		if (!compressed) return nullptr;
+		body = std::move(*compressed);
+	}
+#endif
+
+	auto res = std::make_shared<const std::string>(std::move(body));
+	std::lock_guard cache_lock{ m_cache_mutex };
+	// a concurrent reader may have cached a newer version meanwhile
+	if (!entry.body || entry.version < version) {
+		entry.body = res;
+		entry.version = version;
+	}
+	return res;
+}
+
+}
\ No newline at end of file
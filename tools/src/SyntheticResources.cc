@@ -0,0 +1,63 @@
+#include <random>
+#include <algorithm>
+
+#include <QtCore/QDir>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+
+#include <SyntheticResources.hh>
+
+namespace GenshinArtifactSpawnStat {
+
+namespace {
+
+// smooth gradient with a few shapes and low-amplitude noise, which compresses
+// about as well as real screenshots do
+QImage synthetic_image(const QSize& size, std::mt19937& rng) {
+	QImage img{ size, QImage::Format_RGB32 };
+	std::uniform_int_distribution<int> base{ 0, 255 };
+	std::uniform_int_distribution<int> noise{ -6, 6 };
+	const int r0 = base(rng), g0 = base(rng), b0 = base(rng);
+
+	for (int y = 0; y < img.height(); ++y) {
+		auto* line = reinterpret_cast<QRgb*>(img.scanLine(y));
+		for (int x = 0; x < img.width(); ++x) {
+			const int shade = (x * 64 / std::max(1, img.width())) + (y * 64 / std::max(1, img.height()));
+			line[x] = qRgb(
+			  std::clamp(r0 / 2 + shade + noise(rng), 0, 255),
+			  std::clamp(g0 / 2 + shade + noise(rng), 0, 255),
+			  std::clamp(b0 / 2 + shade + noise(rng), 0, 255));
+		}
+	}
+
+	QPainter p{ &img };
+	std::uniform_int_distribution<int> x_dist{ 0, img.width() };
+	std::uniform_int_distribution<int> y_dist{ 0, img.height() };
+	for (int i = 0; i < 20; ++i) {
+		p.setBrush(QColor::fromRgb(base(rng), base(rng), base(rng)));
+		p.drawEllipse(QPoint{ x_dist(rng), y_dist(rng) }, img.width() / 20 + 1, img.height() / 20 + 1);
+	}
+	return img;
+}
+
+}
+
+bool SyntheticResources::generate(const QString& dir, const Options& opt) {
+	const QDir resource_dir{ QDir{ dir }.filePath("resource") };
+	if (!QDir{}.mkpath(resource_dir.path())) return false;
+
+	std::mt19937 rng{ opt.seed };
+	const int spots = std::clamp(opt.spots, 0, MAX_SPOTS);
+	for (int map = 1; map <= opt.maps; ++map) {
+		const auto stem = QString{ "%1" }.arg(map, 3, 10, QChar{ '0' });
+		if (!synthetic_image(opt.map_size, rng).save(resource_dir.filePath(stem + ".png"))) return false;
+
+		for (int spot = 0; spot < spots; ++spot) {
+			const auto spot_file = resource_dir.filePath(stem + QChar{ 'a' + spot } + ".png");
+			if (!synthetic_image(opt.spot_size, rng).save(spot_file)) return false;
+		}
+	}
+	return true;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cctype>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <LatencyRecorder.hh>
+#include <FdLimit.hh>
+
+namespace {
+
+using namespace GenshinArtifactSpawnStat;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+	std::string host = "localhost";
+	std::string port = "3000";
+	unsigned clients = 1000;
+	unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+	int duration_seconds = 10;
+	int timeout_seconds = 5;
+	double post_ratio = 0.1;
+	int spots = 300;
+	int drops_per_post = 50;
+	std::string accept = "application/json";
+	std::string accept_encoding = "identity";
+};
+
+// one simulated client with a keep-alive connection, sending its next request
+// as soon as the previous response arrived
+struct Client {
+	enum class State {
+		Connecting,
+		Sending,
+		Receiving
+	};
+	int fd = -1;
+	State state = State::Connecting;
+	std::string out;
+	std::size_t out_offset = 0;
+	std::string in;
+	Clock::time_point request_start;
+};
+
+// descriptors besides the client sockets: stdio, resolver, ...
+inline constexpr rlim_t FD_SLACK = 64;
+
+std::atomic<bool> stop_requested{ false };
+std::atomic<bool> failed{ false };
+
+void request_stop(int) {
+	stop_requested = true;
+}
+
+void print_usage(const char* exe) {
+	std::cerr << "Usage: " << exe
+			  << " [--host localhost:3000] [--clients 1000] [--threads <hardware threads>]"
+				 " [--duration <seconds>] [--timeout <seconds>] [--post-ratio 0.1] [--spots 300] [--drops-per-post 50]"
+				 " [--accept application/json] [--accept-encoding identity]"
+			  << std::endl;
+}
+
+std::string make_request(const Options& opt, std::mt19937& rng) {
+	std::uniform_real_distribution<double> coin{ 0.0, 1.0 };
+	if (coin(rng) >= opt.post_ratio)
+		return "GET / HTTP/1.1\r\nHost: " + opt.host +
+			   "\r\nAccept: " + opt.accept +
+			   "\r\nAccept-Encoding: " + opt.accept_encoding + "\r\n\r\n";
+
+	std::uniform_int_distribution<int> row_dist{ 0, std::max(0, opt.spots - 1) };
+	std::uniform_int_distribution<int> drop_dist{ 0, 2 };
+	std::string body = "{\"drops\":[";
+	for (int i = 0; i < opt.drops_per_post; ++i) {
+		if (i > 0) body += ',';
+		body += '[' + std::to_string(row_dist(rng)) + ',' + std::to_string(drop_dist(rng)) + ']';
+	}
+	body += "]}";
+	return "POST / HTTP/1.1\r\nHost: " + opt.host +
+		   "\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) +
+		   "\r\n\r\n" + body;
+}
+
+// returns the total response size if in holds a complete response, 0 otherwise
+std::size_t complete_response_size(const std::string& in, bool& ok, bool& close_after) {
+	const auto header_end = in.find("\r\n\r\n");
+	if (header_end == std::string::npos) return 0;
+
+	std::string header = in.substr(0, header_end);
+	std::transform(header.begin(), header.end(), header.begin(), [](unsigned char c) { return std::tolower(c); });
+	ok = header.compare(0, 12, "http/1.1 200") == 0;
+	close_after = header.find("\r\nconnection: close") != std::string::npos;
+
+	std::size_t content_length = 0;
+	const auto cl = header.find("\r\ncontent-length:");
+	if (cl != std::string::npos) content_length = std::strtoul(header.c_str() + cl + 17, nullptr, 10);
+
+	const auto total = header_end + 4 + content_length;
+	return in.size() >= total ? total : 0;
+}
+
+void run_clients(const Options& opt, const addrinfo* addr, unsigned count, unsigned seed, LatencyRecorder& recorder, Clock::time_point deadline) {
+	std::mt19937 rng{ seed };
+	std::vector<Client> clients(count);
+	std::vector<pollfd> pfds(count);
+	char buffer[64 * 1024];
+
+	auto disconnect = [](Client& c) {
+		if (c.fd >= 0) close(c.fd);
+		c = Client{};
+	};
+
+	auto start_request = [&](Client& c) {
+		c.out = make_request(opt, rng);
+		c.out_offset = 0;
+		c.in.clear();
+		c.request_start = Clock::now();
+		c.state = Client::State::Sending;
+	};
+
+	auto connect_client = [&](Client& c) {
+		c.fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+		if (c.fd < 0) {
+			recorder.record_error();
+			return;
+		}
+		fcntl(c.fd, F_SETFL, fcntl(c.fd, F_GETFL, 0) | O_NONBLOCK);
+		int one = 1;
+		setsockopt(c.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		c.state = Client::State::Connecting;
+		c.request_start = Clock::now();
+		if (connect(c.fd, addr->ai_addr, addr->ai_addrlen) == 0) start_request(c);
+		else if (errno != EINPROGRESS) {
+			recorder.record_error();
+			disconnect(c);
+		}
+	};
+
+	const auto timeout = std::chrono::seconds{ opt.timeout_seconds };
+
+	while (!stop_requested && Clock::now() < deadline) {
+		const auto now = Clock::now();
+		for (std::size_t i = 0; i < count; ++i) {
+			auto& c = clients[i];
+			// a starved client must count, it never produces a latency sample
+			if (c.fd >= 0 && now - c.request_start > timeout) {
+				recorder.record_timeout();
+				disconnect(c);
+			}
+			if (c.fd < 0) connect_client(c);
+			short events = 0;
+			if (c.fd >= 0) events = c.state == Client::State::Receiving ? POLLIN : POLLOUT;
+			pfds[i] = { c.fd, events, 0 };
+		}
+
+		const int ready = poll(pfds.data(), pfds.size(), 100);
+		if (ready < 0 && errno != EINTR) {
+			std::cerr << "poll: " << std::strerror(errno) << std::endl;
+			failed = true;
+			stop_requested = true;
+			break;
+		}
+		if (ready <= 0) continue;
+
+		for (std::size_t i = 0; i < count; ++i) {
+			auto& c = clients[i];
+			const auto revents = pfds[i].revents;
+			if (c.fd < 0 || revents == 0) continue;
+
+			if (c.state == Client::State::Connecting) {
+				int error = 0;
+				socklen_t len = sizeof(error);
+				getsockopt(c.fd, SOL_SOCKET, SO_ERROR, &error, &len);
+				if (error != 0) {
+					recorder.record_error();
+					disconnect(c);
+					continue;
+				}
+				start_request(c);
+			}
+
+			if (c.state == Client::State::Sending) {
+				const auto n = send(c.fd, c.out.data() + c.out_offset, c.out.size() - c.out_offset, 0);
+				if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+					recorder.record_error();
+					disconnect(c);
+					continue;
+				}
+				if (n > 0) c.out_offset += n;
+				if (c.out_offset == c.out.size()) c.state = Client::State::Receiving;
+				continue;
+			}
+
+			if (c.state == Client::State::Receiving) {
+				const auto n = recv(c.fd, buffer, sizeof(buffer), 0);
+				if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+					recorder.record_error();
+					disconnect(c);
+					continue;
+				}
+				if (n > 0) c.in.append(buffer, n);
+
+				bool ok = false;
+				bool close_after = false;
+				if (complete_response_size(c.in, ok, close_after) == 0) continue;
+
+				if (ok) recorder.record(Clock::now() - c.request_start);
+				else recorder.record_error();
+
+				if (close_after) disconnect(c);
+				else start_request(c);
+			}
+		}
+	}
+
+	// requests still open at the end are as slow as the slowest sample at least
+	const auto end = Clock::now();
+	for (auto& c : clients) {
+		if (c.fd < 0) continue;
+		if (end - c.request_start > timeout) recorder.record_timeout();
+		else recorder.record(end - c.request_start);
+		disconnect(c);
+	}
+}
+
+// localhost may resolve to ::1 first while the server only listens on IPv4
+const addrinfo* reachable_address(const addrinfo* addrs) {
+	for (auto* a = addrs; a != nullptr; a = a->ai_next) {
+		const int fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+		if (fd < 0) continue;
+		const bool connected = connect(fd, a->ai_addr, a->ai_addrlen) == 0;
+		close(fd);
+		if (connected) return a;
+	}
+	return nullptr;
+}
+
+}
+
+int main(int argc, char** argv) {
+	Options opt;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			print_usage(argv[0]);
+			return 1;
+		}
+		const std::string value = argv[++i];
+		if (arg == "--host") {
+			const auto colon = value.rfind(':');
+			opt.host = value.substr(0, colon);
+			if (colon != std::string::npos) opt.port = value.substr(colon + 1);
+		} else if (arg == "--clients") opt.clients = std::max(1, std::atoi(value.c_str()));
+		else if (arg == "--threads") opt.threads = std::max(1, std::atoi(value.c_str()));
+		else if (arg == "--duration") opt.duration_seconds = std::max(1, std::atoi(value.c_str()));
+		else if (arg == "--timeout") opt.timeout_seconds = std::max(1, std::atoi(value.c_str()));
+		else if (arg == "--post-ratio") opt.post_ratio = std::atof(value.c_str());
+		else if (arg == "--spots") opt.spots = std::max(1, std::atoi(value.c_str()));
+		else if (arg == "--drops-per-post") opt.drops_per_post = std::max(1, std::atoi(value.c_str()));
+		else if (arg == "--accept") opt.accept = value;
+		else if (arg == "--accept-encoding") opt.accept_encoding = value;
+		else {
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	std::signal(SIGINT, request_stop);
+	std::signal(SIGPIPE, SIG_IGN);
+
+	if (const auto fd_limit = raise_fd_limit(); fd_limit < opt.clients + FD_SLACK) {
+		std::cerr << opt.clients << " clients need " << opt.clients + FD_SLACK << " open files, the limit is "
+				  << fd_limit << ". Raise it with 'ulimit -n' or use fewer clients." << std::endl;
+		return 1;
+	}
+
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* addrs = nullptr;
+	if (const int error = getaddrinfo(opt.host.c_str(), opt.port.c_str(), &hints, &addrs); error != 0) {
+		std::cerr << "Cannot resolve " << opt.host << ": " << gai_strerror(error) << std::endl;
+		return 1;
+	}
+	const addrinfo* addr = reachable_address(addrs);
+	if (addr == nullptr) {
+		std::cerr << "Cannot connect to " << opt.host << ":" << opt.port << std::endl;
+		freeaddrinfo(addrs);
+		return 1;
+	}
+
+	opt.threads = std::min(opt.threads, opt.clients);
+	std::cout << "Simulating " << opt.clients << " clients on " << opt.threads << " threads against "
+			  << opt.host << ":" << opt.port << " for " << opt.duration_seconds << " s" << std::endl;
+
+	LatencyRecorder recorder;
+	const auto deadline = Clock::now() + std::chrono::seconds{ opt.duration_seconds };
+
+	std::vector<std::thread> workers;
+	for (unsigned t = 0; t < opt.threads; ++t) {
+		const unsigned count = opt.clients / opt.threads + (t < opt.clients % opt.threads ? 1 : 0);
+		workers.emplace_back(run_clients, std::cref(opt), addr, count, t + 1, std::ref(recorder), deadline);
+	}
+
+	for (auto next = Clock::now() + std::chrono::seconds{ 1 }; !stop_requested && next <= deadline; next += std::chrono::seconds{ 1 }) {
+		std::this_thread::sleep_until(next);
+		recorder.report_interval(std::cout);
+	}
+
+	for (auto& w : workers)
+		w.join();
+	freeaddrinfo(addrs);
+
+	recorder.report_total(std::cout);
+	return failed ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include <iostream>
+
+#include <QtCore/QString>
+
+#include <SyntheticResources.hh>
+
+int main(int argc, char** argv) {
+	using namespace GenshinArtifactSpawnStat;
+
+	if (argc < 4) {
+		std::cerr << "Usage: " << argv[0] << " <output dir> <maps> <spots per map (max " << SyntheticResources::MAX_SPOTS << ")>"
+				  << " [<map width>x<map height> <spot width>x<spot height>]" << std::endl;
+		return 1;
+	}
+
+	SyntheticResources::Options opt;
+	opt.maps = QString{ argv[2] }.toInt();
+	opt.spots = QString{ argv[3] }.toInt();
+	if (opt.spots > SyntheticResources::MAX_SPOTS) {
+		std::cerr << "At most " << SyntheticResources::MAX_SPOTS << " spots per map" << std::endl;
+		return 1;
+	}
+	if (argc >= 6) {
+		const auto map_size = QString{ argv[4] }.split('x');
+		const auto spot_size = QString{ argv[5] }.split('x');
+		if (map_size.size() == 2) opt.map_size = { map_size[0].toInt(), map_size[1].toInt() };
+		if (spot_size.size() == 2) opt.spot_size = { spot_size[0].toInt(), spot_size[1].toInt() };
+	}
+
+	if (!SyntheticResources::generate(argv[1], opt)) {
+		std::cerr << "Failed to write resources to " << argv[1] << std::endl;
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
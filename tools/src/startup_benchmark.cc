@@ -0,0 +1,183 @@
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include <sys/resource.h>
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTextStream>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QProcess>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QStringList>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QMainWindow>
+
+#include <AppWindow.hh>
+#include <StartupProbe.hh>
+#include <SyntheticResources.hh>
+
+namespace {
+
+using namespace GenshinArtifactSpawnStat;
+
+constexpr auto RESULT_PREFIX = "RESULT";
+constexpr int TIMEOUT_MS = 10 * 60 * 1000;
+
+// stops the event loop at the first paint of the main window
+class FirstPaintFilter : public QObject {
+	const QElapsedTimer& m_clock;
+
+public:
+	qint64 first_paint_ms = -1;
+
+	FirstPaintFilter(const QElapsedTimer& clock) :
+			m_clock{ clock } {}
+
+	bool eventFilter(QObject* obj, QEvent* e) override {
+		if (first_paint_ms < 0 && e->type() == QEvent::Paint && obj->isWidgetType()) {
+			if (qobject_cast<QMainWindow*>(static_cast<QWidget*>(obj)->window())) {
+				first_paint_ms = m_clock.elapsed();
+				QTimer::singleShot(0, qApp, &QApplication::quit);
+			}
+		}
+		return false;
+	}
+};
+
+long peak_rss_kb() {
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+	return usage.ru_maxrss;
+#endif
+}
+
+// measures a single startup in the current working directory
+int run_startup(int argc, char** argv) {
+	QElapsedTimer clock;
+	clock.start();
+
+	QApplication app{ argc, argv };
+	QFile ssfile(":/dark/stylesheet.qss");
+	ssfile.open(QFile::ReadOnly | QFile::Text);
+	app.setStyleSheet(QTextStream{ &ssfile }.readAll());
+
+	std::map<std::string, qint64> phases;
+	StartupProbe::observe([&phases, &clock](const char* phase) {
+		phases[phase] = clock.elapsed();
+	});
+
+	FirstPaintFilter paint_filter{ clock };
+	app.installEventFilter(&paint_filter);
+	QTimer::singleShot(TIMEOUT_MS, &app, &QApplication::quit);
+
+	AppWindow window;
+	app.exec();
+
+	std::cout << RESULT_PREFIX;
+	for (const auto& [phase, ms] : phases)
+		std::cout << " " << phase << "=" << ms;
+	std::cout << " first_paint=" << paint_filter.first_paint_ms
+			  << " peak_rss_kb=" << peak_rss_kb() << std::endl;
+	return 0;
+}
+
+std::map<std::string, std::string> parse_result(const QString& output) {
+	std::map<std::string, std::string> res;
+	for (const auto& line : output.split('\n')) {
+		if (!line.startsWith(RESULT_PREFIX)) continue;
+		for (const auto& field : line.mid(QString{ RESULT_PREFIX }.size()).split(' ', Qt::SkipEmptyParts)) {
+			const auto kv = field.split('=');
+			if (kv.size() == 2) res[kv[0].toStdString()] = kv[1].trimmed().toStdString();
+		}
+	}
+	return res;
+}
+
+void print_usage(const char* exe) {
+	std::cerr << "Usage: " << exe << " [--sizes <maps>x<spots (max " << SyntheticResources::MAX_SPOTS << ")>,...] [--runs <n>]" << std::endl
+			  << "Starts the stats server first to include a real receive() in the measurement." << std::endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+	if (argc >= 2 && std::string{ argv[1] } == "--run") return run_startup(argc, argv);
+
+	QStringList sizes{ "10x5", "50x10", "100x10", "200x20" };
+	int runs = 1;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		const std::string arg = argv[i];
+		if (arg == "--sizes") sizes = QString{ argv[i + 1] }.split(',', Qt::SkipEmptyParts);
+		else if (arg == "--runs") runs = std::max(1, QString{ argv[i + 1] }.toInt());
+		else {
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+	if (argc % 2 == 0) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	const auto self = QFileInfo{ QString::fromLocal8Bit(argv[0]) }.absoluteFilePath();
+	const char* columns[] = { "images_loaded", "shown", "first_paint", "stats_received", "route_loaded" };
+	std::cout << std::setw(6) << "maps" << std::setw(7) << "spots" << std::setw(5) << "run";
+	for (const auto* col : columns)
+		std::cout << std::setw(16) << (std::string{ col } + "_ms");
+	std::cout << std::setw(14) << "peak_rss_mb" << std::endl;
+
+	for (const auto& size : sizes) {
+		const auto dims = size.split('x');
+		if (dims.size() != 2) {
+			print_usage(argv[0]);
+			return 1;
+		}
+
+		SyntheticResources::Options opt;
+		opt.maps = dims[0].toInt();
+		opt.spots = dims[1].toInt();
+		// generate() would cap the spots and the table would show the wrong size
+		if (opt.maps < 1 || opt.spots < 1 || opt.spots > SyntheticResources::MAX_SPOTS) {
+			std::cerr << "Invalid size " << size.toStdString() << ": at least 1 map and 1 to "
+					  << SyntheticResources::MAX_SPOTS << " spots per map" << std::endl;
+			return 1;
+		}
+
+		QTemporaryDir dir;
+		if (!dir.isValid() || !SyntheticResources::generate(dir.path(), opt)) {
+			std::cerr << "Failed to generate resources for " << size.toStdString() << std::endl;
+			return 1;
+		}
+
+		for (int run = 1; run <= runs; ++run) {
+			// fresh process per run so peak RSS belongs to this size only
+			QProcess child;
+			auto env = QProcessEnvironment::systemEnvironment();
+			env.insert("QT_QPA_PLATFORM", "offscreen");
+			child.setProcessEnvironment(env);
+			child.setWorkingDirectory(dir.path());
+			child.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+			child.start(self, { "--run" });
+			if (!child.waitForFinished(TIMEOUT_MS + 10000)) {
+				std::cerr << "Startup timed out for " << size.toStdString() << std::endl;
+				return 1;
+			}
+
+			auto res = parse_result(QString::fromLocal8Bit(child.readAllStandardOutput()));
+			std::cout << std::setw(6) << opt.maps << std::setw(7) << opt.spots << std::setw(5) << run;
+			for (const auto* col : columns)
+				std::cout << std::setw(16) << (res.count(col) ? res[col] : "-");
+			const auto rss_kb = res.count("peak_rss_kb") ? std::stol(res["peak_rss_kb"]) : 0;
+			std::cout << std::setw(14) << std::fixed << std::setprecision(1) << rss_kb / 1024.0 << std::endl;
+		}
+	}
+	return 0;
+}
\ No newline at end of file
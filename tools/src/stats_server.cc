@@ -0,0 +1,115 @@
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <algorithm>
+
+#include <StatsStore.hh>
+#include <HttpServer.hh>
+#include <LatencyRecorder.hh>
+#include <FdLimit.hh>
+
+namespace {
+
+std::atomic<bool> stop_requested{ false };
+
+void request_stop(int) {
+	stop_requested = true;
+}
+
+void print_usage(const char* exe) {
+	std::cerr << "Usage: " << exe << " [--port 3000] [--threads <hardware threads>] [--report <seconds>]" << std::endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+	using namespace GenshinArtifactSpawnStat;
+
+	unsigned short port = 3000;
+	unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+	int report_seconds = 5;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			print_usage(argv[0]);
+			return 1;
+		}
+		if (arg == "--port") port = static_cast<unsigned short>(std::atoi(argv[++i]));
+		else if (arg == "--threads") threads = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--report") report_seconds = std::max(1, std::atoi(argv[++i]));
+		else {
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	std::signal(SIGINT, request_stop);
+	std::signal(SIGTERM, request_stop);
+	std::signal(SIGPIPE, SIG_IGN);
+
+	StatsStore store;
+	LatencyRecorder recorder;
+
+	auto handler = [&store](const HttpServer::Request& req) {
+		HttpServer::Response res;
+		if (req.method == "GET") {
+			// binary stats only for clients asking for them, JSON otherwise
+			auto encoding = StatsStore::Encoding::Json;
+			if (req.accept.find(StatsStore::BINARY_TYPE) != std::string::npos) {
+				encoding = StatsStore::Encoding::Binary;
+				res.content_type = StatsStore::BINARY_TYPE;
+			}
+			const bool gzip = StatsStore::gzip_supported() && req.accept_encoding.find("gzip") != std::string::npos;
+			if (const auto body = store.stats(encoding, gzip)) {
+				if (gzip) res.content_encoding = "gzip";
+				res.body = *body;
+			} else {
+				res.status = 500;
+				res.content_type = StatsStore::JSON_TYPE;
+				res.body = "{\"status\":\"error\"}";
+			}
+		} else if (req.method == "POST") {
+			if (store.submit(req.body)) {
+				res.body = "{\"status\":\"success\"}";
+			} else {
+				res.status = 400;
+				res.body = "{\"status\":\"error\"}";
+			}
+		} else {
+			res.status = 405;
+			res.body = "{\"status\":\"error\"}";
+		}
+		return res;
+	};
+
+	try {
+		HttpServer server{ port, handler, recorder };
+		const auto fd_limit = raise_fd_limit();
+		std::cout << "Serving stats on port " << port << " with " << threads << " threads, up to "
+				  << fd_limit << " open files" << std::endl;
+
+		std::thread reporter{ [&recorder, report_seconds]() {
+			auto next = std::chrono::steady_clock::now();
+			while (!stop_requested) {
+				next += std::chrono::seconds{ report_seconds };
+				while (!stop_requested && std::chrono::steady_clock::now() < next)
+					std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
+				if (!stop_requested) recorder.report_interval(std::cout);
+			}
+		} };
+
+		server.run(threads, stop_requested);
+		reporter.join();
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	recorder.report_total(std::cout);
+	return 0;
+}
\ No newline at end of file